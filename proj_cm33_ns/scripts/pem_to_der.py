@@ -0,0 +1,117 @@
+#!/usr/bin/env python
+
+#******************************************************************************
+# File Name:   pem_to_der.py
+#
+# Description: Converts the PEM credentials of network_credentials.h to DER
+# arrays at build time, so that the server does not decode PEM at start-up.
+#
+#******************************************************************************
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************/
+
+import base64
+import re
+import sys
+
+# Macros of network_credentials.h, and the names of the arrays generated for
+# them.
+CREDENTIALS = (("keySERVER_CERTIFICATE_PEM", "tcp_server_cert_der"),
+               ("keySERVER_PRIVATE_KEY_PEM", "server_private_key_der"),
+               ("keyCLIENT_ROOTCA_PEM", "tcp_client_ca_cert_der"))
+
+BYTES_PER_LINE = 12
+
+
+def macro_string(header, macro):
+    """Returns the concatenated string literals of a #define."""
+    match = re.search(r"#define\s+%s\s*\\\n((?:\s*\".*\"\s*\\?\n)+)" % macro, header)
+    if match is None:
+        sys.exit("pem_to_der.py: %s not found" % macro)
+    literals = re.findall(r"\"((?:[^\"\\]|\\.)*)\"", match.group(1))
+    return "".join(literals).replace("\\n", "\n")
+
+
+def pem_to_der(pem):
+    """Decodes the base64 body of a single PEM block."""
+    lines = [line.strip() for line in pem.strip().splitlines()]
+    if not lines[0].startswith("-----BEGIN ") or not lines[-1].startswith("-----END "):
+        sys.exit("pem_to_der.py: malformed PEM block")
+    return base64.b64decode("".join(lines[1:-1]))
+
+
+def c_array(name, der):
+    """Formats a DER blob as a const array and its const length. A NUL byte
+    follows the blob outside of its length: the secure sockets library hands
+    mbedTLS the length plus the terminator of a PEM string."""
+    data = list(der) + [0]
+    rows = []
+    for start in range(0, len(data), BYTES_PER_LINE):
+        rows.append("    " + ", ".join("0x%02x" % b for b in data[start:start + BYTES_PER_LINE]))
+    return ("static const uint8_t %s[] =\n{\n%s\n};\n"
+            "static const size_t %s_len = %dU;\n" % (name, ",\n".join(rows), name, len(der)))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: pem_to_der.py <network_credentials.h> <output header>")
+
+    with open(sys.argv[1]) as source:
+        header = source.read()
+
+    out = ["/* Generated by scripts/pem_to_der.py from network_credentials.h at build",
+           " * time. Do not edit. */",
+           "#ifndef NETWORK_CREDENTIALS_DER_H_",
+           "#define NETWORK_CREDENTIALS_DER_H_",
+           "",
+           "#include <stddef.h>",
+           "#include <stdint.h>",
+           ""]
+    for macro, name in CREDENTIALS:
+        out.append(c_array(name, pem_to_der(macro_string(header, macro))))
+    out.append("#endif /* NETWORK_CREDENTIALS_DER_H_ */")
+
+    text = "\n".join(out) + "\n"
+    try:
+        with open(sys.argv[2]) as previous:
+            if previous.read() == text:
+                # Leave the file untouched so that make does not rebuild.
+                return
+    except OSError:
+        pass
+
+    with open(sys.argv[2], "w") as generated:
+        generated.write(text)
+
+
+if __name__ == "__main__":
+    main()
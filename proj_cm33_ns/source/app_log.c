@@ -0,0 +1,242 @@
+/******************************************************************************
+* File Name:   app_log.c
+*
+* Description: This file contains a deferred logger. A record holds the
+* address of its format string and its arguments; it is queued to a RAM ring
+* by the caller and formatted and printed by a low-priority drain task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* Standard C header files */
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+/* Deferred logger header file */
+#include "app_log.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define APP_LOG_RING_MASK                              (APP_LOG_RING_SIZE - 1U)
+
+#if ((APP_LOG_RING_SIZE & APP_LOG_RING_MASK) != 0U)
+#error "APP_LOG_RING_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Log record. The format string stays in flash; only its address is copied. */
+typedef struct
+{
+    const char *format;
+    uint32_t argc;
+    uint32_t args[APP_LOG_MAX_ARGS];
+} app_log_record_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Record ring. head and tail run freely and are reduced modulo
+ * APP_LOG_RING_SIZE when indexing the records. */
+static app_log_record_t log_ring[APP_LOG_RING_SIZE];
+static volatile uint32_t log_head;
+static volatile uint32_t log_tail;
+
+/* Number of records dropped because the ring was full. */
+static volatile uint32_t log_dropped;
+
+/* Drain task, notified by the writer that makes the ring non-empty. */
+static TaskHandle_t log_task_handle;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void app_log_task(void *arg);
+
+/*******************************************************************************
+ * Function Name: app_log_init
+ *******************************************************************************
+ * Summary:
+ *  Creates the task printing the queued log records.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_rslt_t: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t app_log_init(void)
+{
+    if(pdPASS != xTaskCreate(app_log_task, "Log task", APP_LOG_TASK_STACK_SIZE, NULL,
+                             APP_LOG_TASK_PRIORITY, &log_task_handle))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: app_log_write
+ *******************************************************************************
+ * Summary:
+ *  Queues a log record. Called through the APP_LOG_* macros; safe to call
+ *  from any task or interrupt. The record is dropped if the ring is full.
+ *  The drain task is notified when the record is the only one in the ring;
+ *  otherwise it is already due to run.
+ *
+ * Parameters:
+ *  const char *format: printf format of the record
+ *  uint32_t argc: Number of arguments following the format
+ *  ...: 32-bit integer or pointer arguments
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void app_log_write(const char *format, uint32_t argc, ...)
+{
+    UBaseType_t interrupt_mask;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    app_log_record_t *record;
+    va_list args;
+    uint32_t index;
+    bool wake = false;
+
+    interrupt_mask = taskENTER_CRITICAL_FROM_ISR();
+    if((log_head - log_tail) >= APP_LOG_RING_SIZE)
+    {
+        log_dropped++;
+    }
+    else
+    {
+        record = &log_ring[log_head & APP_LOG_RING_MASK];
+        record->format = format;
+        record->argc = argc;
+
+        va_start(args, argc);
+        for(index = 0; index < argc; index++)
+        {
+            record->args[index] = va_arg(args, uint32_t);
+        }
+        va_end(args);
+
+        wake = (log_head == log_tail);
+        log_head++;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(interrupt_mask);
+
+    /* Records written before the drain task exists are printed once it
+     * starts. */
+    if(wake && (NULL != log_task_handle))
+    {
+        if(xPortIsInsideInterrupt())
+        {
+            vTaskNotifyGiveFromISR(log_task_handle, &higher_priority_task_woken);
+            portYIELD_FROM_ISR(higher_priority_task_woken);
+        }
+        else
+        {
+            xTaskNotifyGive(log_task_handle);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: app_log_task
+ *******************************************************************************
+ * Summary:
+ *  Drain task. Prints every queued record through retarget-io, then blocks
+ *  until a writer makes the ring non-empty again.
+ *
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void app_log_task(void *arg)
+{
+    app_log_record_t record;
+    uint32_t dropped;
+    uint32_t reported_dropped = 0U;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while(true)
+    {
+        while(log_tail != log_head)
+        {
+            /* Copy the record out before releasing its slot to the writers. */
+            taskENTER_CRITICAL();
+            record = log_ring[log_tail & APP_LOG_RING_MASK];
+            log_tail++;
+            taskEXIT_CRITICAL();
+
+            /* Arguments beyond record.argc are never read by the format. */
+            printf(record.format, record.args[0], record.args[1], record.args[2],
+                   record.args[3], record.args[4], record.args[5]);
+        }
+
+        dropped = log_dropped;
+        if(dropped != reported_dropped)
+        {
+            printf("Log ring full, %"PRIu32" record(s) dropped\n", dropped - reported_dropped);
+            reported_dropped = dropped;
+        }
+
+        /* A record queued while the ring was being drained already left a
+         * notification pending, so this returns right away in that case. */
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+/* [] END OF FILE */
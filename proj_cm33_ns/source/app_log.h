@@ -0,0 +1,129 @@
+/******************************************************************************
+* File Name:   app_log.h
+*
+* Description: This file is the public interface of app_log.c, a deferred
+* logger. Records are queued to a RAM ring and printed from a low-priority
+* task, so that logging does not stall the caller on the debug UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef APP_LOG_H_
+#define APP_LOG_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include "cy_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Log levels. */
+#define APP_LOG_LEVEL_NONE                        (0)
+#define APP_LOG_LEVEL_ERROR                       (1)
+#define APP_LOG_LEVEL_WARN                        (2)
+#define APP_LOG_LEVEL_INFO                        (3)
+#define APP_LOG_LEVEL_DEBUG                       (4)
+
+/* Records above this level are compiled out, arguments included. Set from
+ * the Makefile with APP_LOG_LEVEL. */
+#ifndef APP_LOG_LEVEL
+#define APP_LOG_LEVEL                             (APP_LOG_LEVEL_INFO)
+#endif
+
+/* Number of records the ring holds. Must be a power of two. */
+#define APP_LOG_RING_SIZE                         (64U)
+
+/* Maximum number of arguments of a record. */
+#define APP_LOG_MAX_ARGS                          (6U)
+
+/* Drain task settings. The task runs at idle priority so that printing never
+ * delays the network tasks. It is woken when the ring becomes non-empty. */
+#define APP_LOG_TASK_STACK_SIZE                   (1024U)
+#define APP_LOG_TASK_PRIORITY                     (0U)
+
+/* Number of arguments following the format, from 0 to APP_LOG_MAX_ARGS. */
+#define APP_LOG_NARGS(...)                        APP_LOG_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define APP_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, count, ...) count
+
+/* Logging macros. The format is a printf format that is only read when the
+ * record is printed, so it must be a string literal. Every argument must be
+ * a 32-bit integer or a pointer, and strings passed to %s must remain valid
+ * until the record is printed.
+ */
+#if (APP_LOG_LEVEL >= APP_LOG_LEVEL_ERROR)
+#define APP_LOG_ERROR(format, ...)                app_log_write(format, APP_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define APP_LOG_ERROR(format, ...)                do { } while(0)
+#endif
+
+#if (APP_LOG_LEVEL >= APP_LOG_LEVEL_WARN)
+#define APP_LOG_WARN(format, ...)                 app_log_write(format, APP_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define APP_LOG_WARN(format, ...)                 do { } while(0)
+#endif
+
+#if (APP_LOG_LEVEL >= APP_LOG_LEVEL_INFO)
+#define APP_LOG_INFO(format, ...)                 app_log_write(format, APP_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define APP_LOG_INFO(format, ...)                 do { } while(0)
+#endif
+
+#if (APP_LOG_LEVEL >= APP_LOG_LEVEL_DEBUG)
+#define APP_LOG_DEBUG(format, ...)                app_log_write(format, APP_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define APP_LOG_DEBUG(format, ...)                do { } while(0)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t app_log_init(void);
+void app_log_write(const char *format, uint32_t argc, ...);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* APP_LOG_H_ */
+
+/* [] END OF FILE */
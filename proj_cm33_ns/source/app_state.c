@@ -0,0 +1,229 @@
+/******************************************************************************
+* File Name:   app_state.c
+*
+* Description: This file contains the application state shared between the
+* user button ISR, the server task and the secure sockets callback thread. The
+* small fields live in one state word that is only changed with C11 atomic
+* compare-and-swap, so no update needs a critical section and no reader sees
+* a torn value. Every update also advances the sequence number kept in the word, which
+* lets readers take a consistent snapshot of the word and the fields next to it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include <stdatomic.h>
+#include "app_state.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Layout of the state word. */
+#define APP_STATE_LED_ON                          (1UL << 0U)
+#define APP_STATE_CLIENTS_POS                     (8U)
+#define APP_STATE_CLIENTS_MASK                    (0xFFUL << APP_STATE_CLIENTS_POS)
+#define APP_STATE_SEQUENCE_POS                    (16U)
+#define APP_STATE_SEQUENCE_ONE                    (1UL << APP_STATE_SEQUENCE_POS)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* State word. */
+static atomic_uint_least32_t app_state_word;
+
+/* Time of the last accepted button press, in milliseconds. Only written by
+ * the user button ISR, which advances the sequence right after. */
+static atomic_uint_least32_t app_state_last_press_ms;
+
+/*******************************************************************************
+ * Function Name: app_state_update
+ *******************************************************************************
+ * Summary:
+ *  Atomically applies a change to the state word and advances its sequence.
+ *  The compare-and-swap fails if an interrupt or another task changed the
+ *  word since it was loaded, in which case the change is applied again to the
+ *  new value. Safe from interrupt and task context.
+ *
+ * Parameters:
+ *  uint32_t clear: State bits to clear
+ *  uint32_t set: State bits to set
+ *  int32_t clients: Amount to add to the connected client count
+ *
+ * Return:
+ *  uint32_t: New value of the state word.
+ *
+ *******************************************************************************/
+static uint32_t app_state_update(uint32_t clear, uint32_t set, int32_t clients)
+{
+    uint_least32_t word = atomic_load_explicit(&app_state_word, memory_order_relaxed);
+    uint32_t updated;
+    uint32_t count;
+
+    do
+    {
+        count = ((word & APP_STATE_CLIENTS_MASK) >> APP_STATE_CLIENTS_POS) + (uint32_t)clients;
+        updated = (word & ~(clear | APP_STATE_CLIENTS_MASK)) | set |
+                  ((count << APP_STATE_CLIENTS_POS) & APP_STATE_CLIENTS_MASK);
+        updated += APP_STATE_SEQUENCE_ONE;
+    } while(!atomic_compare_exchange_weak_explicit(&app_state_word, &word, updated,
+                                                   memory_order_acq_rel, memory_order_relaxed));
+
+    return updated;
+}
+
+/*******************************************************************************
+ * Function Name: app_state_set_led
+ *******************************************************************************
+ * Summary:
+ *  Records the LED state acknowledged by a TCP client.
+ *
+ * Parameters:
+ *  bool led_on: true if the LED is on
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void app_state_set_led(bool led_on)
+{
+    (void)app_state_update(APP_STATE_LED_ON, led_on ? APP_STATE_LED_ON : 0U, 0);
+}
+
+/*******************************************************************************
+ * Function Name: app_state_client_connected
+ *******************************************************************************
+ * Summary:
+ *  Counts a TCP client that completed its handshake.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t: Number of connected TCP clients.
+ *
+ *******************************************************************************/
+uint32_t app_state_client_connected(void)
+{
+    return (app_state_update(0U, 0U, 1) & APP_STATE_CLIENTS_MASK) >> APP_STATE_CLIENTS_POS;
+}
+
+/*******************************************************************************
+ * Function Name: app_state_client_disconnected
+ *******************************************************************************
+ * Summary:
+ *  Uncounts a TCP client that was connected.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t: Number of connected TCP clients.
+ *
+ *******************************************************************************/
+uint32_t app_state_client_disconnected(void)
+{
+    return (app_state_update(0U, 0U, -1) & APP_STATE_CLIENTS_MASK) >> APP_STATE_CLIENTS_POS;
+}
+
+/*******************************************************************************
+ * Function Name: app_state_button_press
+ *******************************************************************************
+ * Summary:
+ *  Debounces a user button press and records it if it is accepted. Must only
+ *  be called from the user button ISR, the single writer of the press time.
+ *
+ * Parameters:
+ *  uint32_t now_ms: Time of the press, in milliseconds
+ *  uint32_t debounce_ms: Minimum time since the last accepted press
+ *  bool *led_on: Filled in with the LED state at the time of the press
+ *
+ * Return:
+ *  bool: true if the press is accepted.
+ *
+ *******************************************************************************/
+bool app_state_button_press(uint32_t now_ms, uint32_t debounce_ms, bool *led_on)
+{
+    uint32_t word;
+
+    if((now_ms - atomic_load_explicit(&app_state_last_press_ms, memory_order_relaxed)) <
+       debounce_ms)
+    {
+        return false;
+    }
+
+    /* Publish the press time together with the next sequence number. */
+    atomic_store_explicit(&app_state_last_press_ms, now_ms, memory_order_relaxed);
+    word = app_state_update(0U, 0U, 0);
+    *led_on = (0U != (word & APP_STATE_LED_ON));
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: app_state_snapshot
+ *******************************************************************************
+ * Summary:
+ *  Takes a consistent copy of the application state. The copy is retried if
+ *  the state changed while it was taken.
+ *
+ * Parameters:
+ *  app_state_snapshot_t *snapshot: Destination of the copy
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void app_state_snapshot(app_state_snapshot_t *snapshot)
+{
+    uint32_t word;
+    uint32_t last_press_ms;
+
+    do
+    {
+        word = atomic_load_explicit(&app_state_word, memory_order_acquire);
+        last_press_ms = atomic_load_explicit(&app_state_last_press_ms, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while(word != atomic_load_explicit(&app_state_word, memory_order_relaxed));
+
+    snapshot->sequence = word >> APP_STATE_SEQUENCE_POS;
+    snapshot->led_on = (0U != (word & APP_STATE_LED_ON));
+    snapshot->connected_clients = (word & APP_STATE_CLIENTS_MASK) >> APP_STATE_CLIENTS_POS;
+    snapshot->last_press_ms = last_press_ms;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name:   app_state.h
+*
+* Description: This file contains the declarations of the application state
+* shared between the user button ISR, the server task and the secure sockets
+* callback thread.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef APP_STATE_H_
+#define APP_STATE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Consistent copy of the application state. sequence changes on every
+ * update, so two snapshots with the same sequence saw the same state.
+ */
+typedef struct
+{
+    uint32_t sequence;
+    bool led_on;
+    uint32_t connected_clients;
+    uint32_t last_press_ms;
+} app_state_snapshot_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void app_state_set_led(bool led_on);
+uint32_t app_state_client_connected(void);
+uint32_t app_state_client_disconnected(void);
+bool app_state_button_press(uint32_t now_ms, uint32_t debounce_ms, bool *led_on);
+void app_state_snapshot(app_state_snapshot_t *snapshot);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* APP_STATE_H_ */
+
+/* [] END OF FILE */
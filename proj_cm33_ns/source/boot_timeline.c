@@ -0,0 +1,199 @@
+/******************************************************************************
+* File Name:   boot_timeline.c
+*
+* Description: This file contains the start-up timeline of the secure TCP
+* server. Every start-up step is stamped with the time elapsed since the
+* board was initialized, and the timeline is printed once the server listens.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* Standard C header files */
+#include <stdbool.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+/* DWT cycle counter header file */
+#include "cycle_counter.h"
+
+/* Start-up timeline header file */
+#include "boot_timeline.h"
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Start-up step. The name must remain valid until the timeline is printed. */
+typedef struct
+{
+    const char *name;
+    uint32_t time_ms;
+} boot_timeline_mark_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+static boot_timeline_mark_t boot_marks[BOOT_TIMELINE_MAX_MARKS];
+static uint32_t boot_mark_count;
+
+/* Cycle count at the origin of the timeline. Before the scheduler starts,
+ * time is taken from the cycle counter. Afterwards it is taken from the tick
+ * count, relative to the first step stamped by a task: unlike the cycle
+ * counter, it does not wrap within a start-up and keeps counting through
+ * tickless idle. */
+static uint32_t boot_start_cycles;
+static bool boot_ticks_based;
+static uint32_t boot_base_ms;
+static TickType_t boot_base_tick;
+
+/*******************************************************************************
+ * Function Name: boot_timeline_init
+ *******************************************************************************
+ * Summary:
+ *  Starts the cycle counter and records the origin of the timeline. Must be
+ *  called by main() right after cybsp_init(), once the core runs at its final
+ *  clock. The boot ROM, the secure image and cybsp_init() run before it and
+ *  are not covered.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void boot_timeline_init(void)
+{
+    (void)cycle_counter_init();
+    boot_start_cycles = cycle_counter_read();
+    boot_timeline_mark("Board initialized");
+}
+
+/*******************************************************************************
+ * Function Name: boot_timeline_elapsed_ms
+ *******************************************************************************
+ * Summary:
+ *  Returns the time elapsed since the origin of the timeline. Once the
+ *  scheduler runs, must only be called from a single task.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t: Elapsed time in milliseconds.
+ *
+ *******************************************************************************/
+uint32_t boot_timeline_elapsed_ms(void)
+{
+    uint32_t cycles_ms = (cycle_counter_read() - boot_start_cycles) /
+                         (SystemCoreClock / 1000U);
+
+    if(taskSCHEDULER_NOT_STARTED == xTaskGetSchedulerState())
+    {
+        return cycles_ms;
+    }
+
+    if(!boot_ticks_based)
+    {
+        boot_base_ms = cycles_ms;
+        boot_base_tick = xTaskGetTickCount();
+        boot_ticks_based = true;
+    }
+
+    return boot_base_ms + (uint32_t)((xTaskGetTickCount() - boot_base_tick) *
+                                     portTICK_PERIOD_MS);
+}
+
+/*******************************************************************************
+ * Function Name: boot_timeline_mark
+ *******************************************************************************
+ * Summary:
+ *  Stamps the completion of a start-up step.
+ *
+ * Parameters:
+ *  const char *name: Name of the step, a string literal
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void boot_timeline_mark(const char *name)
+{
+    if(boot_mark_count < BOOT_TIMELINE_MAX_MARKS)
+    {
+        boot_marks[boot_mark_count].name = name;
+        boot_marks[boot_mark_count].time_ms = boot_timeline_elapsed_ms();
+        boot_mark_count++;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: boot_timeline_print
+ *******************************************************************************
+ * Summary:
+ *  Prints every step with its time since the origin of the timeline and the
+ *  duration of the step.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void boot_timeline_print(void)
+{
+    uint32_t previous_ms = 0U;
+    uint32_t index;
+
+    printf("Start-up timeline (ms since the board was initialized):\n");
+    for(index = 0; index < boot_mark_count; index++)
+    {
+        printf("  %6"PRIu32" ms  +%6"PRIu32" ms  %s\n", boot_marks[index].time_ms,
+                boot_marks[index].time_ms - previous_ms, boot_marks[index].name);
+        previous_ms = boot_marks[index].time_ms;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,75 @@
+/******************************************************************************
+* File Name:   boot_timeline.h
+*
+* Description: This file is the public interface of boot_timeline.c, the
+* start-up timeline of the secure TCP server.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BOOT_TIMELINE_H_
+#define BOOT_TIMELINE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Maximum number of steps recorded. Later steps are ignored. */
+#define BOOT_TIMELINE_MAX_MARKS                   (12U)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void boot_timeline_init(void);
+void boot_timeline_mark(const char *name);
+uint32_t boot_timeline_elapsed_ms(void);
+void boot_timeline_print(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* BOOT_TIMELINE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,462 @@
+/******************************************************************************
+* File Name:   crypto_benchmark.c
+*
+* Description: This file contains a benchmark of the PSA crypto
+* operations that dominate the cost of a TLS connection: the ECDHE and ECDSA
+* operations of a handshake, and AES-GCM and SHA-256 over record-sized data.
+* It reports the CPU cycles per operation of whichever PSA driver the build
+* selected.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* Standard C header files */
+#include <stdio.h>
+#include <inttypes.h>
+
+/* PSA crypto API header file */
+#include "psa/crypto.h"
+
+/* DWT cycle counter header file */
+#include "cycle_counter.h"
+
+/* Crypto benchmark header file */
+#include "crypto_benchmark.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define CRYPTO_BENCHMARK_ECC_BITS                      (256U)
+#define CRYPTO_BENCHMARK_AES_KEY_LEN                   (16U)
+#define CRYPTO_BENCHMARK_GCM_NONCE_LEN                 (12U)
+#define CRYPTO_BENCHMARK_GCM_TAG_LEN                   (16U)
+#define CRYPTO_BENCHMARK_SHA256_LEN                    (32U)
+#define CRYPTO_BENCHMARK_ECDSA_SIG_LEN                 (64U)
+#define CRYPTO_BENCHMARK_ECC_PUBLIC_KEY_LEN            (65U)
+
+/* Implementation actually measured, from the configuration psa/crypto.h was
+ * built with rather than from CRYPTO_HW_ACCEL alone. */
+#if defined(MBEDTLS_PSA_CRYPTO_DRIVERS) && defined(IFX_PSA_MXCRYPTO_PRESENT)
+#define CRYPTO_BENCHMARK_BACKEND                       "MXCRYPTO PSA driver"
+#else
+#define CRYPTO_BENCHMARK_BACKEND                       "mbedTLS software"
+#endif
+
+#if (0 != CRYPTO_HW_ACCEL) && \
+    !(defined(MBEDTLS_PSA_CRYPTO_DRIVERS) && defined(IFX_PSA_MXCRYPTO_PRESENT))
+#warning "CRYPTO_HW_ACCEL is set but the MXCRYPTO PSA driver is not enabled"
+#endif
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Operation under test. handshake_count is the number of times a handshake
+ * performs it, for the estimate of the crypto cost of a handshake. */
+typedef struct
+{
+    const char *name;
+    psa_status_t (*run)(void);
+    uint32_t iterations;
+    uint32_t handshake_count;
+} crypto_benchmark_op_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static psa_status_t crypto_benchmark_setup(void);
+static void crypto_benchmark_teardown(void);
+static psa_status_t crypto_benchmark_ecc_keygen(void);
+static psa_status_t crypto_benchmark_ecdh(void);
+static psa_status_t crypto_benchmark_ecdsa_sign(void);
+static psa_status_t crypto_benchmark_ecdsa_verify(void);
+static psa_status_t crypto_benchmark_aes_gcm(void);
+static psa_status_t crypto_benchmark_sha256(void);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Keys used by the operations. */
+static psa_key_id_t sign_key = PSA_KEY_ID_NULL;
+static psa_key_id_t ecdh_key = PSA_KEY_ID_NULL;
+static psa_key_id_t aes_key = PSA_KEY_ID_NULL;
+
+/* Operation inputs and outputs. */
+static uint8_t peer_public_key[CRYPTO_BENCHMARK_ECC_PUBLIC_KEY_LEN];
+static size_t peer_public_key_len;
+static uint8_t hash[CRYPTO_BENCHMARK_SHA256_LEN];
+static uint8_t signature[CRYPTO_BENCHMARK_ECDSA_SIG_LEN];
+static size_t signature_len;
+static uint8_t bulk_input[CRYPTO_BENCHMARK_BULK_LEN];
+static uint8_t bulk_output[CRYPTO_BENCHMARK_BULK_LEN + CRYPTO_BENCHMARK_GCM_TAG_LEN];
+
+/* Operations, in the order of a server-side ECDHE-ECDSA handshake with
+ * client authentication, followed by the bulk operations of a record. The
+ * server signs its key exchange once and verifies both the client
+ * certificate and the CertificateVerify message. */
+static const crypto_benchmark_op_t crypto_benchmark_ops[] =
+{
+    { "ECDHE key generation", crypto_benchmark_ecc_keygen,   CRYPTO_BENCHMARK_ECC_ITERATIONS,  1U },
+    { "ECDH shared secret",   crypto_benchmark_ecdh,         CRYPTO_BENCHMARK_ECC_ITERATIONS,  1U },
+    { "ECDSA P-256 sign",     crypto_benchmark_ecdsa_sign,   CRYPTO_BENCHMARK_ECC_ITERATIONS,  1U },
+    { "ECDSA P-256 verify",   crypto_benchmark_ecdsa_verify, CRYPTO_BENCHMARK_ECC_ITERATIONS,  2U },
+    { "AES-128-GCM encrypt",  crypto_benchmark_aes_gcm,      CRYPTO_BENCHMARK_BULK_ITERATIONS, 0U },
+    { "SHA-256",              crypto_benchmark_sha256,       CRYPTO_BENCHMARK_BULK_ITERATIONS, 0U }
+};
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_run
+ *******************************************************************************
+ * Summary:
+ *  Times every operation and prints its average cost in CPU cycles and
+ *  microseconds, followed by an estimate of the crypto cost of a full
+ *  handshake. The estimate is the sum of the primitives a handshake performs,
+ *  weighted by their count; it leaves out the X.509 parsing, the record layer
+ *  and the network round trips of a real handshake.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void crypto_benchmark_run(void)
+{
+    psa_status_t status;
+    uint64_t total_cycles;
+    uint64_t handshake_cycles = 0U;
+    uint32_t cycles_per_op;
+    uint32_t start;
+    uint32_t op;
+    uint32_t iteration;
+
+    (void)cycle_counter_init();
+
+    status = crypto_benchmark_setup();
+    if(PSA_SUCCESS != status)
+    {
+        printf("Crypto benchmark setup failed! Error: %"PRId32"\n", status);
+        crypto_benchmark_teardown();
+        return;
+    }
+
+    printf("Crypto benchmark (%s, %"PRIu32" MHz):\n",
+            CRYPTO_BENCHMARK_BACKEND,
+            SystemCoreClock / 1000000U);
+
+    for(op = 0; op < (sizeof(crypto_benchmark_ops) / sizeof(crypto_benchmark_ops[0])); op++)
+    {
+        total_cycles = 0U;
+        status = PSA_SUCCESS;
+        for(iteration = 0; (iteration < crypto_benchmark_ops[op].iterations) &&
+                           (PSA_SUCCESS == status); iteration++)
+        {
+            start = cycle_counter_read();
+            status = crypto_benchmark_ops[op].run();
+            total_cycles += cycle_counter_read() - start;
+        }
+
+        if(PSA_SUCCESS != status)
+        {
+            printf("  %-22s failed! Error: %"PRId32"\n", crypto_benchmark_ops[op].name, status);
+            continue;
+        }
+
+        cycles_per_op = (uint32_t)(total_cycles / crypto_benchmark_ops[op].iterations);
+        handshake_cycles += (uint64_t)cycles_per_op * crypto_benchmark_ops[op].handshake_count;
+        printf("  %-22s %10"PRIu32" cycles/op %8"PRIu32" us/op\n",
+                crypto_benchmark_ops[op].name, cycles_per_op,
+                cycles_per_op / (SystemCoreClock / 1000000U));
+    }
+
+    printf("  %-22s %10"PRIu32" cycles    %8"PRIu32" us\n", "Handshake (sum of ops)",
+            (uint32_t)handshake_cycles,
+            (uint32_t)(handshake_cycles / (SystemCoreClock / 1000000U)));
+    printf("  (bulk operations over %u bytes)\n", CRYPTO_BENCHMARK_BULK_LEN);
+
+    crypto_benchmark_teardown();
+}
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_setup
+ *******************************************************************************
+ * Summary:
+ *  Creates the keys and the inputs of the operations.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  psa_status_t: PSA_SUCCESS or the first error.
+ *
+ *******************************************************************************/
+static psa_status_t crypto_benchmark_setup(void)
+{
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_key_id_t peer_key = PSA_KEY_ID_NULL;
+    psa_status_t status;
+    size_t hash_len;
+    uint32_t index;
+
+    status = psa_crypto_init();
+    if(PSA_SUCCESS != status)
+    {
+        return status;
+    }
+
+    for(index = 0; index < sizeof(bulk_input); index++)
+    {
+        bulk_input[index] = (uint8_t)index;
+    }
+
+    /* Signing key. */
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_HASH | PSA_KEY_USAGE_VERIFY_HASH);
+    psa_set_key_algorithm(&attributes, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+    psa_set_key_bits(&attributes, CRYPTO_BENCHMARK_ECC_BITS);
+    status = psa_generate_key(&attributes, &sign_key);
+
+    /* Key agreement keys: ours and the public half of the peer's. */
+    if(PSA_SUCCESS == status)
+    {
+        psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_DERIVE);
+        psa_set_key_algorithm(&attributes, PSA_ALG_ECDH);
+        status = psa_generate_key(&attributes, &ecdh_key);
+    }
+    if(PSA_SUCCESS == status)
+    {
+        status = psa_generate_key(&attributes, &peer_key);
+    }
+    if(PSA_SUCCESS == status)
+    {
+        status = psa_export_public_key(peer_key, peer_public_key, sizeof(peer_public_key),
+                                       &peer_public_key_len);
+        (void)psa_destroy_key(peer_key);
+    }
+
+    /* Record protection key. */
+    if(PSA_SUCCESS == status)
+    {
+        psa_reset_key_attributes(&attributes);
+        psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_ENCRYPT);
+        psa_set_key_algorithm(&attributes, PSA_ALG_GCM);
+        psa_set_key_type(&attributes, PSA_KEY_TYPE_AES);
+        psa_set_key_bits(&attributes, CRYPTO_BENCHMARK_AES_KEY_LEN * 8U);
+        status = psa_generate_key(&attributes, &aes_key);
+    }
+
+    /* Hash to sign and a signature to verify. */
+    if(PSA_SUCCESS == status)
+    {
+        status = psa_hash_compute(PSA_ALG_SHA_256, bulk_input, sizeof(bulk_input),
+                                  hash, sizeof(hash), &hash_len);
+    }
+    if(PSA_SUCCESS == status)
+    {
+        status = crypto_benchmark_ecdsa_sign();
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_teardown
+ *******************************************************************************
+ * Summary:
+ *  Destroys the keys created by crypto_benchmark_setup().
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void crypto_benchmark_teardown(void)
+{
+    (void)psa_destroy_key(sign_key);
+    (void)psa_destroy_key(ecdh_key);
+    (void)psa_destroy_key(aes_key);
+    sign_key = PSA_KEY_ID_NULL;
+    ecdh_key = PSA_KEY_ID_NULL;
+    aes_key = PSA_KEY_ID_NULL;
+}
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_ecc_keygen
+ *******************************************************************************
+ * Summary:
+ *  Generates and destroys an ephemeral P-256 key pair.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  psa_status_t: Status of the operation.
+ *
+ *******************************************************************************/
+static psa_status_t crypto_benchmark_ecc_keygen(void)
+{
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_key_id_t key;
+    psa_status_t status;
+
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_DERIVE);
+    psa_set_key_algorithm(&attributes, PSA_ALG_ECDH);
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+    psa_set_key_bits(&attributes, CRYPTO_BENCHMARK_ECC_BITS);
+
+    status = psa_generate_key(&attributes, &key);
+    if(PSA_SUCCESS == status)
+    {
+        status = psa_destroy_key(key);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_ecdh
+ *******************************************************************************
+ * Summary:
+ *  Computes the ECDH shared secret with the peer public key.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  psa_status_t: Status of the operation.
+ *
+ *******************************************************************************/
+static psa_status_t crypto_benchmark_ecdh(void)
+{
+    uint8_t secret[CRYPTO_BENCHMARK_ECC_BITS / 8U];
+    size_t secret_len;
+
+    return psa_raw_key_agreement(PSA_ALG_ECDH, ecdh_key, peer_public_key, peer_public_key_len,
+                                 secret, sizeof(secret), &secret_len);
+}
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_ecdsa_sign
+ *******************************************************************************
+ * Summary:
+ *  Signs the SHA-256 hash with the P-256 signing key.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  psa_status_t: Status of the operation.
+ *
+ *******************************************************************************/
+static psa_status_t crypto_benchmark_ecdsa_sign(void)
+{
+    return psa_sign_hash(sign_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), hash, sizeof(hash),
+                         signature, sizeof(signature), &signature_len);
+}
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_ecdsa_verify
+ *******************************************************************************
+ * Summary:
+ *  Verifies the signature of the SHA-256 hash.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  psa_status_t: Status of the operation.
+ *
+ *******************************************************************************/
+static psa_status_t crypto_benchmark_ecdsa_verify(void)
+{
+    return psa_verify_hash(sign_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), hash, sizeof(hash),
+                           signature, signature_len);
+}
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_aes_gcm
+ *******************************************************************************
+ * Summary:
+ *  Encrypts and authenticates the bulk input with AES-128-GCM, as done for
+ *  every TLS record.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  psa_status_t: Status of the operation.
+ *
+ *******************************************************************************/
+static psa_status_t crypto_benchmark_aes_gcm(void)
+{
+    static const uint8_t nonce[CRYPTO_BENCHMARK_GCM_NONCE_LEN] = { 0U };
+    size_t output_len;
+
+    return psa_aead_encrypt(aes_key, PSA_ALG_GCM, nonce, sizeof(nonce), NULL, 0U,
+                            bulk_input, sizeof(bulk_input), bulk_output, sizeof(bulk_output),
+                            &output_len);
+}
+
+/*******************************************************************************
+ * Function Name: crypto_benchmark_sha256
+ *******************************************************************************
+ * Summary:
+ *  Hashes the bulk input with SHA-256, as done for the handshake transcript.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  psa_status_t: Status of the operation.
+ *
+ *******************************************************************************/
+static psa_status_t crypto_benchmark_sha256(void)
+{
+    uint8_t digest[CRYPTO_BENCHMARK_SHA256_LEN];
+    size_t digest_len;
+
+    return psa_hash_compute(PSA_ALG_SHA_256, bulk_input, sizeof(bulk_input),
+                            digest, sizeof(digest), &digest_len);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name:   crypto_benchmark.h
+*
+* Description: This file is the public interface of crypto_benchmark.c,
+* which times the PSA crypto operations of a TLS handshake and of bulk record
+* protection.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CRYPTO_BENCHMARK_H_
+#define CRYPTO_BENCHMARK_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Set this macro to '1' to time the crypto operations at start-up and print
+ * the results. Build with CRYPTO_HW_ACCEL=1 and CRYPTO_HW_ACCEL=0 in the
+ * Makefile to compare the crypto block with the software implementation.
+ */
+#define CRYPTO_BENCHMARK_ENABLE                   (0U)
+
+/* Iterations of the public key and of the symmetric operations. */
+#define CRYPTO_BENCHMARK_ECC_ITERATIONS           (8U)
+#define CRYPTO_BENCHMARK_BULK_ITERATIONS          (64U)
+
+/* Input size of the bulk operations. A TLS record can carry up to 16 KiB of
+ * plaintext, but the records this server sends hold at most one transmit
+ * batch, so the default is TCP_SESSION_TX_BATCH_SIZE (512 bytes). */
+#define CRYPTO_BENCHMARK_BULK_LEN                 (512U)
+
+/* Set by the Makefile. */
+#ifndef CRYPTO_HW_ACCEL
+#define CRYPTO_HW_ACCEL                           (0)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void crypto_benchmark_run(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* CRYPTO_BENCHMARK_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,611 @@
+/******************************************************************************
+* File Name:   eth_link.c
+*
+* Description: This file contains the Ethernet link monitor of the secure TCP
+* server. It brings the link up with a bounded exponential backoff, reuses the
+* last DHCP lease to skip the DHCP wait when the link comes back, renews that
+* lease through DHCP in the background and reconnects whenever the link is
+* lost.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* Standard C header files */
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* IP address related header files (part of the lwIP TCP/IP stack). */
+#include "ip_addr.h"
+
+/* lwIP DHCP client and thread-safe netif API header files */
+#include "lwip/dhcp.h"
+#include "lwip/netifapi.h"
+
+/* Network interface of the connection manager */
+#include "cy_network_mw_core.h"
+
+/* Ethernet connection manager header files */
+#include "cy_ecm.h"
+#include "cy_ecm_error.h"
+/* Ethernet PHY header file */
+#include "cy_eth_phy_driver.h"
+
+/* Deferred logger header file */
+#include "app_log.h"
+
+/* Power policy header file, for the wake-up timestamps */
+#include "power_policy.h"
+
+/* Ethernet link monitor header file */
+#include "eth_link.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Notification bits set by the connection manager event handler. */
+#define ETH_LINK_DOWN_NOTIFY_BIT                       (1UL << 0U)
+#define ETH_LINK_IP_CHANGED_NOTIFY_BIT                 (1UL << 1U)
+
+#define ETH_LINK_NOTIFY_ALL_BITS                       (0xFFFFFFFFUL)
+
+/* Period at which a background DHCP client is checked for a bound lease. */
+#define ETH_LINK_DHCP_POLL_MS                          (1000U)
+
+/* Age limit of the cached lease, in ticks. Not computed with pdMS_TO_TICKS,
+ * whose intermediate product overflows for this duration. */
+#define ETH_LINK_LEASE_MAX_AGE_TICKS                   ((TickType_t)(ETH_LINK_LEASE_MAX_AGE_MS / \
+                                                                     portTICK_PERIOD_MS))
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void eth_link_task(void *arg);
+static void eth_link_event_handler(cy_ecm_event_t event, cy_ecm_event_data_t *event_data);
+static bool eth_link_connect(bool reuse_lease, bool *on_cached_lease);
+static bool eth_link_dhcp_start(void);
+static bool eth_link_dhcp_bound(void);
+static void eth_link_cache_lease(const cy_ecm_ip_address_t *ip_addr);
+static void eth_link_set_up(const cy_ecm_ip_address_t *ip_addr, TickType_t up_tick,
+                            bool link_came_up);
+static void eth_link_set_down(void);
+#if (ETH_LINK_WAKE_TIMING_ENABLE)
+static void eth_link_wake_irq_handler(void);
+#endif
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Ethernet PHY callback functions */
+static cy_ecm_phy_callbacks_t phy_callbacks =
+{
+    .phy_init = cy_eth_phy_init,
+    .phy_configure = cy_eth_phy_configure,
+    .phy_enable_ext_reg = cy_eth_phy_enable_ext_reg,
+    .phy_discover = cy_eth_phy_discover,
+    .phy_get_auto_neg_status = cy_eth_phy_get_auto_neg_status,
+    .phy_get_link_partner_cap = cy_eth_phy_get_link_partner_cap,
+    .phy_get_linkspeed = cy_eth_phy_get_linkspeed,
+    .phy_get_linkstatus = cy_eth_phy_get_linkstatus,
+    .phy_reset = cy_eth_phy_reset
+};
+
+/* Ethernet connection manager handle */
+static cy_ecm_t ecm_handle = NULL;
+
+/* Link monitor task and the callback it reports link changes to. */
+static TaskHandle_t eth_link_task_handle;
+static eth_link_callback_t eth_link_callback;
+
+/* Link state, written by the link monitor task only. */
+static eth_link_status_t eth_link_status;
+
+/* Last DHCP lease and the time it was obtained. */
+static cy_ecm_ip_setting_t eth_link_lease;
+static bool eth_link_lease_valid;
+static TickType_t eth_link_lease_tick;
+
+#if (ETH_LINK_WAKE_TIMING_ENABLE)
+/* Ethernet interrupt handler installed by the connection manager. */
+static cy_israddress eth_link_ecm_irq_handler;
+#endif
+
+/*******************************************************************************
+ * Function Name: eth_link_init
+ *******************************************************************************
+ * Summary:
+ *  Initializes the Ethernet connection manager and the interface, and starts
+ *  the link monitor task that brings the link up. The callback is called once
+ *  the link is up; the link may take any time to come up, so this function
+ *  does not wait for it.
+ *
+ * Parameters:
+ *  eth_link_callback_t callback: Function told about every link change
+ *
+ * Return:
+ *  cy_rslt_t: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t eth_link_init(eth_link_callback_t callback)
+{
+    cy_rslt_t result;
+
+    /* Initialize Ethernet connection manager. */
+    result = cy_ecm_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Ethernet connection manager initialization failed! Error code: 0x%08"PRIx32"\n",
+               (uint32_t)result);
+        return result;
+    }
+
+    printf("Ethernet connection manager initialized.\n");
+
+    /* Initialize the Ethernet interface and PHY driver */
+    result = cy_ecm_ethif_init(CY_ECM_INTERFACE_ETH0, &phy_callbacks, &ecm_handle);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Ethernet interface initialization failed! Error code: 0x%08"PRIx32"\n",
+               (uint32_t)result);
+        return result;
+    }
+
+#if (ETH_LINK_WAKE_TIMING_ENABLE)
+    /* Timestamp the wake-ups caused by the Ethernet interrupt ahead of the
+     * handler of the connection manager. */
+    eth_link_ecm_irq_handler = Cy_SysInt_SetVector(ETH_LINK_WAKE_IRQ, eth_link_wake_irq_handler);
+#endif
+
+    result = cy_ecm_register_event_callback(ecm_handle, eth_link_event_handler);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to register the Ethernet event callback! Error code: 0x%08"PRIx32"\n",
+               (uint32_t)result);
+        return result;
+    }
+
+    eth_link_callback = callback;
+
+    if(pdPASS != xTaskCreate(eth_link_task, "Link task", ETH_LINK_TASK_STACK_SIZE, NULL,
+                             ETH_LINK_TASK_PRIORITY, &eth_link_task_handle))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: eth_link_get_status
+ *******************************************************************************
+ * Summary:
+ *  Returns a consistent copy of the link state.
+ *
+ * Parameters:
+ *  eth_link_status_t *status: Destination of the copy
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void eth_link_get_status(eth_link_status_t *status)
+{
+    taskENTER_CRITICAL();
+    *status = eth_link_status;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+ * Function Name: eth_link_task
+ *******************************************************************************
+ * Summary:
+ *  Brings the link up, retrying with a delay that doubles after every failed
+ *  attempt, then waits for the link to go down and starts over. A link that
+ *  came up on the cached lease starts DHCP in the background, which renews
+ *  the lease without taking the link down.
+ *
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void eth_link_task(void *arg)
+{
+    uint32_t notify_bits;
+    uint32_t attempts;
+    uint32_t backoff_ms;
+    TickType_t wait;
+    cy_ecm_ip_address_t ip_addr;
+    bool on_cached_lease = false;
+    bool dhcp_pending;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while(true)
+    {
+        attempts = 0U;
+        backoff_ms = ETH_LINK_BACKOFF_MIN_MS;
+
+        while(true)
+        {
+            /* Events of the previous connection are stale by now. */
+            (void)xTaskNotifyWait(0U, ETH_LINK_NOTIFY_ALL_BITS, &notify_bits, 0U);
+
+            /* Only the first attempt uses the cached lease, so that a lease
+             * the network no longer accepts costs a single attempt. */
+            if(eth_link_connect(0U == attempts, &on_cached_lease))
+            {
+                break;
+            }
+
+            attempts++;
+            APP_LOG_WARN("Ethernet connection attempt %"PRIu32" failed, retrying in "
+                         "%"PRIu32" ms\n", attempts, backoff_ms);
+            vTaskDelay(pdMS_TO_TICKS(backoff_ms));
+
+            backoff_ms = (backoff_ms >= (ETH_LINK_BACKOFF_MAX_MS / 2U)) ?
+                         ETH_LINK_BACKOFF_MAX_MS : (backoff_ms * 2U);
+        }
+
+        /* The cached lease only saved the wait for DHCP. Run DHCP on the
+         * interface now; it keeps the cached address until it binds a lease,
+         * and then renews that lease like after a regular connection. */
+        dhcp_pending = on_cached_lease && eth_link_dhcp_start();
+
+        /* Wait for the link to go down. While DHCP runs in the background,
+         * also wake up periodically to see whether it has bound a lease. */
+        while(true)
+        {
+            wait = dhcp_pending ? pdMS_TO_TICKS(ETH_LINK_DHCP_POLL_MS) : portMAX_DELAY;
+
+            notify_bits = 0U;
+            (void)xTaskNotifyWait(0U, ETH_LINK_NOTIFY_ALL_BITS, &notify_bits, wait);
+
+            if(0U != (notify_bits & ETH_LINK_DOWN_NOTIFY_BIT))
+            {
+                APP_LOG_WARN("Ethernet link down, reconnecting\n");
+                break;
+            }
+
+            if(dhcp_pending && eth_link_dhcp_bound())
+            {
+                dhcp_pending = false;
+                APP_LOG_INFO("DHCP lease bound in the background\n");
+
+                if(CY_RSLT_SUCCESS == cy_ecm_get_ip_address(ecm_handle, &ip_addr))
+                {
+                    eth_link_cache_lease(&ip_addr);
+                    if(0 != memcmp(&ip_addr, &eth_link_status.ipv4, sizeof(ip_addr)))
+                    {
+                        eth_link_set_up(&ip_addr, eth_link_status.up_tick, false);
+                    }
+                }
+            }
+
+            /* The DHCP server handed out another address on renewal. */
+            if((0U != (notify_bits & ETH_LINK_IP_CHANGED_NOTIFY_BIT)) &&
+               (CY_RSLT_SUCCESS == cy_ecm_get_ip_address(ecm_handle, &ip_addr)))
+            {
+                eth_link_cache_lease(&ip_addr);
+                eth_link_set_up(&ip_addr, eth_link_status.up_tick, false);
+            }
+        }
+
+        eth_link_set_down();
+        cy_ecm_disconnect(ecm_handle);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: eth_link_event_handler
+ *******************************************************************************
+ * Summary:
+ *  Ethernet connection manager event callback. Hands the event over to the
+ *  link monitor task.
+ *
+ * Parameters:
+ *  cy_ecm_event_t event: Connection manager event
+ *  cy_ecm_event_data_t *event_data: Event data (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void eth_link_event_handler(cy_ecm_event_t event, cy_ecm_event_data_t *event_data)
+{
+    CY_UNUSED_PARAMETER(event_data);
+
+    if(NULL == eth_link_task_handle)
+    {
+        return;
+    }
+
+    if(CY_ECM_EVENT_DISCONNECTED == event)
+    {
+        xTaskNotify(eth_link_task_handle, ETH_LINK_DOWN_NOTIFY_BIT, eSetBits);
+    }
+    else if(CY_ECM_EVENT_IP_CHANGED == event)
+    {
+        xTaskNotify(eth_link_task_handle, ETH_LINK_IP_CHANGED_NOTIFY_BIT, eSetBits);
+    }
+}
+
+#if (ETH_LINK_WAKE_TIMING_ENABLE)
+/*******************************************************************************
+ * Function Name: eth_link_wake_irq_handler
+ *******************************************************************************
+ * Summary:
+ *  Ethernet interrupt handler. Tells the power policy that the Ethernet MAC
+ *  is a wake source, then runs the handler of the connection manager.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void eth_link_wake_irq_handler(void)
+{
+    power_policy_wake_source();
+    eth_link_ecm_irq_handler();
+}
+#endif
+
+/*******************************************************************************
+ * Function Name: eth_link_connect
+ *******************************************************************************
+ * Summary:
+ *  Makes one attempt to connect to the network, with the cached lease if
+ *  allowed and still young enough, or with DHCP otherwise.
+ *
+ * Parameters:
+ *  bool reuse_lease: true to connect with the cached lease if there is one
+ *  bool *on_cached_lease: Set to true if the cached lease was used
+ *
+ * Return:
+ *  bool: true if the link is up.
+ *
+ *******************************************************************************/
+static bool eth_link_connect(bool reuse_lease, bool *on_cached_lease)
+{
+    cy_rslt_t result;
+    cy_ecm_ip_setting_t *static_ip = NULL;
+    cy_ecm_ip_address_t ip_addr;
+    TickType_t attempt_tick = xTaskGetTickCount();
+
+#if (ETH_LINK_LEASE_REUSE_ENABLE)
+    if(reuse_lease && eth_link_lease_valid &&
+       ((attempt_tick - eth_link_lease_tick) < ETH_LINK_LEASE_MAX_AGE_TICKS))
+    {
+        static_ip = &eth_link_lease;
+    }
+#else
+    CY_UNUSED_PARAMETER(reuse_lease);
+#endif
+
+    result = cy_ecm_connect(ecm_handle, static_ip, &ip_addr);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return false;
+    }
+
+    if(NULL == static_ip)
+    {
+        eth_link_cache_lease(&ip_addr);
+        printf("Successfully connected to ethernet.\n");
+    }
+    else
+    {
+        printf("Successfully connected to ethernet with the cached lease.\n");
+    }
+
+    *on_cached_lease = (NULL != static_ip);
+    eth_link_set_up(&ip_addr, attempt_tick, true);
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: eth_link_dhcp_start
+ *******************************************************************************
+ * Summary:
+ *  Starts the lwIP DHCP client on the interface brought up with the cached
+ *  lease. The client runs in the lwIP thread and does not touch the address
+ *  of the interface until it has bound a lease.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool: true if the DHCP client was started.
+ *
+ *******************************************************************************/
+static bool eth_link_dhcp_start(void)
+{
+    struct netif *netif = (struct netif *)cy_network_get_nw_interface(CY_NETWORK_ETH_INTERFACE, 0U);
+
+    if((NULL == netif) || (ERR_OK != netifapi_dhcp_start(netif)))
+    {
+        APP_LOG_WARN("Failed to start DHCP, keeping the cached lease\n");
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: eth_link_dhcp_bound
+ *******************************************************************************
+ * Summary:
+ *  Tells whether the background DHCP client has bound a lease.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool: true once DHCP supplies the address of the interface.
+ *
+ *******************************************************************************/
+static bool eth_link_dhcp_bound(void)
+{
+    struct netif *netif = (struct netif *)cy_network_get_nw_interface(CY_NETWORK_ETH_INTERFACE, 0U);
+
+    return (NULL != netif) && (0U != dhcp_supplied_address(netif));
+}
+
+/*******************************************************************************
+ * Function Name: eth_link_cache_lease
+ *******************************************************************************
+ * Summary:
+ *  Keeps the address, gateway and netmask handed out by the DHCP server for the
+ *  next time the link comes up.
+ *
+ * Parameters:
+ *  const cy_ecm_ip_address_t *ip_addr: Address assigned by the DHCP server
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void eth_link_cache_lease(const cy_ecm_ip_address_t *ip_addr)
+{
+    eth_link_lease_valid = false;
+    eth_link_lease.ip_address = *ip_addr;
+
+    if((CY_RSLT_SUCCESS == cy_ecm_get_gateway_address(ecm_handle, &eth_link_lease.gateway)) &&
+       (CY_RSLT_SUCCESS == cy_ecm_get_netmask(ecm_handle, &eth_link_lease.netmask)))
+    {
+        eth_link_lease_tick = xTaskGetTickCount();
+        eth_link_lease_valid = true;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: eth_link_set_up
+ *******************************************************************************
+ * Summary:
+ *  Publishes the addresses of the interface and tells the callback that the
+ *  link is up.
+ *
+ * Parameters:
+ *  const cy_ecm_ip_address_t *ip_addr: IPv4 address of the interface
+ *  TickType_t up_tick: Start of the attempt that brought the link up
+ *  bool link_came_up: true if the link just came up, false if only the
+ *   address changed
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void eth_link_set_up(const cy_ecm_ip_address_t *ip_addr, TickType_t up_tick,
+                            bool link_came_up)
+{
+    cy_ecm_ip_address_t ipv6_addr;
+    bool ipv6_valid;
+    char addr_text[IPADDR_STRLEN_MAX];
+
+    ipv6_valid = (CY_RSLT_SUCCESS == cy_ecm_get_ipv6_address(ecm_handle, CY_ECM_IPV6_LINK_LOCAL,
+                                                              &ipv6_addr));
+
+    printf("IPv4 address assigned: %s\n",
+           ip4addr_ntoa_r((const ip4_addr_t*)&ip_addr->ip.v4, addr_text, sizeof(addr_text)));
+    if(ipv6_valid)
+    {
+        printf("IPv6 address (link-local) assigned: %s\n",
+               ip6addr_ntoa_r((const ip6_addr_t*)&ipv6_addr.ip.v6, addr_text, sizeof(addr_text)));
+    }
+
+    taskENTER_CRITICAL();
+    eth_link_status.up = true;
+    eth_link_status.ipv4 = *ip_addr;
+    eth_link_status.ipv6_valid = ipv6_valid;
+    if(ipv6_valid)
+    {
+        eth_link_status.ipv6 = ipv6_addr;
+    }
+    eth_link_status.up_tick = up_tick;
+    if(link_came_up)
+    {
+        eth_link_status.up_count++;
+    }
+    taskEXIT_CRITICAL();
+
+    if(NULL != eth_link_callback)
+    {
+        eth_link_callback(true);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: eth_link_set_down
+ *******************************************************************************
+ * Summary:
+ *  Marks the link down and tells the callback.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void eth_link_set_down(void)
+{
+    taskENTER_CRITICAL();
+    eth_link_status.up = false;
+    eth_link_status.ipv6_valid = false;
+    taskEXIT_CRITICAL();
+
+    if(NULL != eth_link_callback)
+    {
+        eth_link_callback(false);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name:   eth_link.h
+*
+* Description: This file is the public interface of eth_link.c, the Ethernet
+* link monitor of the secure TCP server.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ETH_LINK_H_
+#define ETH_LINK_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "cy_result.h"
+#include "cy_ecm.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Delay before the second connection attempt. It doubles after every failed
+ * attempt up to ETH_LINK_BACKOFF_MAX_MS; the first attempt is immediate. */
+#define ETH_LINK_BACKOFF_MIN_MS                   (250U)
+#define ETH_LINK_BACKOFF_MAX_MS                   (16000U)
+
+/* Set to 1 to bring the link back up with the address of the last DHCP lease
+ * instead of waiting for DHCP, which then renews the lease in the background.
+ * The cached lease is only used while it is younger than
+ * ETH_LINK_LEASE_MAX_AGE_MS, which must be below the lease time of the DHCP
+ * server; once it is older, the link waits for DHCP as usual. */
+#define ETH_LINK_LEASE_REUSE_ENABLE               (1U)
+#define ETH_LINK_LEASE_MAX_AGE_MS                 (30UL * 60UL * 1000UL)
+
+/* Set to 1 to timestamp the wake-ups from Deep Sleep caused by received
+ * frames in the Ethernet interrupt (see power_policy_wake_source()). The link
+ * monitor then runs ahead of the interrupt handler the connection manager
+ * installed for ETH_LINK_WAKE_IRQ, which must be the Ethernet MAC interrupt
+ * the connection manager uses on the target. */
+#define ETH_LINK_WAKE_TIMING_ENABLE               (0U)
+#define ETH_LINK_WAKE_IRQ                         (eth_interrupt_eth_0_IRQn)
+
+/* Link monitor task settings. */
+#define ETH_LINK_TASK_STACK_SIZE                  (1024U * 2U)
+#define ETH_LINK_TASK_PRIORITY                    (1U)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* State of the link, as reported by eth_link_get_status(). */
+typedef struct
+{
+    bool up;
+    /* Addresses assigned to the interface while the link is up. */
+    cy_ecm_ip_address_t ipv4;
+    bool ipv6_valid;
+    cy_ecm_ip_address_t ipv6;
+    /* Start of the connection attempt that brought the link up. */
+    TickType_t up_tick;
+    /* Number of times the link came up since boot. */
+    uint32_t up_count;
+} eth_link_status_t;
+
+/* Called by the link monitor task every time the link comes up or goes
+ * down. It must not block. */
+typedef void (*eth_link_callback_t)(bool up);
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t eth_link_init(eth_link_callback_t callback);
+void eth_link_get_status(eth_link_status_t *status);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* ETH_LINK_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,673 @@
+/******************************************************************************
+* File Name:   ipc_offload.c
+*
+* Description: This file contains the CM33 side of the IPC pipeline that
+* offloads frame processing to CM55. Requests are copied into descriptors of
+* a shared-memory ring and CM55 is notified through an IPC doorbell; CM55
+* reports completions through a second doorbell. Every session is attached
+* to one core, chosen from the CPU load of both cores and the sessions they
+* serve. Requests are executed on CM33 when their session is on CM33, or when
+* CM55 is not running or already has IPC_OFFLOAD_MAX_INFLIGHT requests queued.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#include <timers.h>
+
+/* Standard C header files */
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* DWT cycle counter header file */
+#include "cycle_counter.h"
+
+/* IPC offload pipeline header file */
+#include "ipc_offload.h"
+
+/* Runtime performance counters header file */
+#include "server_stats.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define IPC_OFFLOAD_DESC_MASK                          (IPC_OFFLOAD_DESC_COUNT - 1U)
+
+#define IPC_OFFLOAD_PERMILLE                           (1000U)
+
+#if ((IPC_OFFLOAD_DESC_COUNT & IPC_OFFLOAD_DESC_MASK) != 0U)
+#error "IPC_OFFLOAD_DESC_COUNT must be a power of two"
+#endif
+
+#if (IPC_OFFLOAD_MAX_INFLIGHT > IPC_OFFLOAD_DESC_COUNT)
+#error "IPC_OFFLOAD_MAX_INFLIGHT must not exceed IPC_OFFLOAD_DESC_COUNT"
+#endif
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Submitter state of a descriptor, kept out of shared memory. */
+typedef struct
+{
+    ipc_offload_callback_t callback;
+    void *arg;
+    void *handle;
+} ipc_offload_pending_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Shared block. CM55 learns its address from the request doorbell. */
+CY_SECTION_SHAREDMEM static ipc_offload_shared_t ipc_offload_shared
+    CY_ALIGN(IPC_OFFLOAD_CACHE_LINE);
+
+static ipc_offload_pending_t pending[IPC_OFFLOAD_DESC_COUNT];
+
+/* Serializes submitters, which own ipc_offload_shared.head. */
+static SemaphoreHandle_t submit_mutex;
+
+/* Task running the completion callbacks, which owns ipc_offload_shared.tail. */
+static TaskHandle_t completion_task_handle;
+
+static ipc_offload_stats_t offload_stats;
+
+/* CPU load measurement. The timer samples the busy time of both cores every
+ * IPC_OFFLOAD_LOAD_PERIOD_MS: the run time of the non-idle tasks of CM33,
+ * and the cycles CM55 spent executing the requests it completed, summed up
+ * by the completion task. */
+static TimerHandle_t load_timer;
+static volatile uint32_t cm55_busy_cycles;
+static volatile uint32_t core_load[IPC_OFFLOAD_CORE_COUNT];
+static uint32_t load_last_runtime;
+static uint32_t load_last_idle;
+static uint32_t load_last_cm55_busy;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static bool ipc_offload_dispatch(uint32_t op, const uint8_t *data, uint32_t length,
+                                 uint32_t min_len, ipc_offload_callback_t callback,
+                                 void *arg, void *handle);
+static void ipc_offload_completion_isr(void);
+static void ipc_offload_completion_task(void *arg);
+static void ipc_offload_load_callback(TimerHandle_t timer);
+static void ipc_offload_execute_local(uint32_t op, const uint8_t *data, uint32_t length,
+                                      ipc_offload_completion_t *completion);
+
+/*******************************************************************************
+ * Function Name: ipc_offload_init
+ *******************************************************************************
+ * Summary:
+ *  Resets the shared block and sets up the completion doorbell and task. Must
+ *  be called before CM55 is enabled.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_rslt_t: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t ipc_offload_init(void)
+{
+    cy_stc_sysint_t completion_intr_cfg =
+    {
+        .intrSrc = IPC_OFFLOAD_CPL_IRQ,
+        .intrPriority = IPC_OFFLOAD_CPL_IRQ_PRIORITY
+    };
+
+    memset(&ipc_offload_shared, 0, sizeof(ipc_offload_shared));
+    ipc_offload_shared.size = sizeof(ipc_offload_shared);
+    __DMB();
+    ipc_offload_shared.magic = IPC_OFFLOAD_MAGIC;
+    __DMB();
+
+    /* Hand the block to CM55. The doorbell stays pending until the worker
+     * starts and reads it. */
+    (void)Cy_IPC_Drv_SendMsgWord(Cy_IPC_Drv_GetIpcBaseAddress(IPC_OFFLOAD_REQ_CHANNEL),
+                                 1UL << IPC_OFFLOAD_REQ_INTR,
+                                 (uint32_t)(uintptr_t)&ipc_offload_shared);
+
+    submit_mutex = xSemaphoreCreateMutex();
+    if(NULL == submit_mutex)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    if(pdPASS != xTaskCreate(ipc_offload_completion_task, "Offload task",
+                             IPC_OFFLOAD_TASK_STACK_SIZE, NULL, IPC_OFFLOAD_TASK_PRIORITY,
+                             &completion_task_handle))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    load_timer = xTimerCreate("Offload load", pdMS_TO_TICKS(IPC_OFFLOAD_LOAD_PERIOD_MS),
+                              pdTRUE, NULL, ipc_offload_load_callback);
+    if((NULL == load_timer) || (pdPASS != xTimerStart(load_timer, 0U)))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    if(CY_SYSINT_SUCCESS != Cy_SysInt_Init(&completion_intr_cfg, ipc_offload_completion_isr))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    Cy_IPC_Drv_SetInterruptMask(Cy_IPC_Drv_GetIntrBaseAddr(IPC_OFFLOAD_CPL_INTR),
+                                CY_IPC_NO_NOTIFICATION, 1UL << IPC_OFFLOAD_CPL_CHANNEL);
+    NVIC_EnableIRQ(completion_intr_cfg.intrSrc);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_attach
+ *******************************************************************************
+ * Summary:
+ *  Attaches a new session to a core. The session goes to the core whose CPU
+ *  load is lower by more than IPC_OFFLOAD_LOAD_MARGIN_PERMILLE, and otherwise
+ *  to the core serving fewer sessions, CM55 on a tie. It goes to CM33 while
+ *  CM55 is not serving requests. A session stays on its core until it is
+ *  detached.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  ipc_offload_core_t: Core the session is attached to.
+ *
+ *******************************************************************************/
+ipc_offload_core_t ipc_offload_attach(void)
+{
+    ipc_offload_core_t core = IPC_OFFLOAD_CORE_CM33;
+    uint32_t cm33_load = core_load[IPC_OFFLOAD_CORE_CM33];
+    uint32_t cm55_load = core_load[IPC_OFFLOAD_CORE_CM55];
+
+    xSemaphoreTake(submit_mutex, portMAX_DELAY);
+    if(IPC_OFFLOAD_MAGIC == ipc_offload_shared.worker_ready)
+    {
+        if((cm55_load + IPC_OFFLOAD_LOAD_MARGIN_PERMILLE) < cm33_load)
+        {
+            core = IPC_OFFLOAD_CORE_CM55;
+        }
+        else if((cm33_load + IPC_OFFLOAD_LOAD_MARGIN_PERMILLE) >= cm55_load)
+        {
+            core = (offload_stats.sessions[IPC_OFFLOAD_CORE_CM55] <=
+                    offload_stats.sessions[IPC_OFFLOAD_CORE_CM33]) ?
+                   IPC_OFFLOAD_CORE_CM55 : IPC_OFFLOAD_CORE_CM33;
+        }
+    }
+    offload_stats.sessions[core]++;
+    xSemaphoreGive(submit_mutex);
+
+    return core;
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_detach
+ *******************************************************************************
+ * Summary:
+ *  Detaches a closed session from its core.
+ *
+ * Parameters:
+ *  ipc_offload_core_t core: Core returned by ipc_offload_attach()
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void ipc_offload_detach(ipc_offload_core_t core)
+{
+    xSemaphoreTake(submit_mutex, portMAX_DELAY);
+    offload_stats.sessions[core]--;
+    xSemaphoreGive(submit_mutex);
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_submit
+ *******************************************************************************
+ * Summary:
+ *  Queues a request of a session on CM55 to CM55, or executes it on CM33 if
+ *  it is shorter than IPC_OFFLOAD_MIN_LEN or CM55 is not serving requests or
+ *  is busy. The requests of a session on CM33 are always executed on CM33.
+ *  The callback is invoked exactly once, either before this function returns
+ *  or later from the completion task.
+ *
+ * Parameters:
+ *  ipc_offload_core_t core: Core the session of the request is attached to
+ *  uint32_t op: Operation, one of ipc_offload_op_t
+ *  const uint8_t *data: Input, copied before the function returns
+ *  uint32_t length: Input length
+ *  ipc_offload_callback_t callback: Completion callback
+ *  void *arg: Argument of the callback
+ *  void *handle: Argument of the callback
+ *
+ * Return:
+ *  bool: true if the request was queued to CM55.
+ *
+ *******************************************************************************/
+bool ipc_offload_submit(ipc_offload_core_t core, uint32_t op, const uint8_t *data,
+                        uint32_t length, ipc_offload_callback_t callback, void *arg,
+                        void *handle)
+{
+    /* No request of a session on CM33 reaches the offload threshold. */
+    uint32_t min_len = (IPC_OFFLOAD_CORE_CM55 == core) ? IPC_OFFLOAD_MIN_LEN :
+                                                         (IPC_OFFLOAD_MAX_DATA_LEN + 1U);
+
+    return ipc_offload_dispatch(op, data, length, min_len, callback, arg, handle);
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_dispatch
+ *******************************************************************************
+ * Summary:
+ *  Implements ipc_offload_submit() with a given offload threshold, so that
+ *  the benchmark can also time the requests below IPC_OFFLOAD_MIN_LEN.
+ *
+ * Parameters:
+ *  uint32_t op: Operation, one of ipc_offload_op_t
+ *  const uint8_t *data: Input, copied before the function returns
+ *  uint32_t length: Input length
+ *  uint32_t min_len: Shortest input queued to CM55
+ *  ipc_offload_callback_t callback: Completion callback
+ *  void *arg: Argument of the callback
+ *  void *handle: Argument of the callback
+ *
+ * Return:
+ *  bool: true if the request was queued to CM55.
+ *
+ *******************************************************************************/
+static bool ipc_offload_dispatch(uint32_t op, const uint8_t *data, uint32_t length,
+                                 uint32_t min_len, ipc_offload_callback_t callback,
+                                 void *arg, void *handle)
+{
+    ipc_offload_completion_t completion;
+    ipc_offload_desc_t *desc;
+    uint32_t head;
+    bool offloaded = false;
+
+    xSemaphoreTake(submit_mutex, portMAX_DELAY);
+    head = ipc_offload_shared.head.value;
+    if((IPC_OFFLOAD_MAGIC == ipc_offload_shared.worker_ready) &&
+       (length >= min_len) && (length <= IPC_OFFLOAD_MAX_DATA_LEN) &&
+       ((head - ipc_offload_shared.tail.value) < IPC_OFFLOAD_MAX_INFLIGHT))
+    {
+        desc = &ipc_offload_shared.desc[head & IPC_OFFLOAD_DESC_MASK];
+        desc->op = op;
+        desc->length = length;
+        memcpy(desc->data, data, length);
+        pending[head & IPC_OFFLOAD_DESC_MASK] = (ipc_offload_pending_t)
+        {
+            .callback = callback,
+            .arg = arg,
+            .handle = handle
+        };
+
+        /* Publish the descriptor only after it has been written. */
+        __DMB();
+        ipc_offload_shared.head.value = head + 1U;
+        __DMB();
+
+        /* A busy doorbell means CM55 has not yet taken the previous
+         * notification, and it drains the whole ring when it does. */
+        (void)Cy_IPC_Drv_SendMsgWord(Cy_IPC_Drv_GetIpcBaseAddress(IPC_OFFLOAD_REQ_CHANNEL),
+                                     1UL << IPC_OFFLOAD_REQ_INTR,
+                                     (uint32_t)(uintptr_t)&ipc_offload_shared);
+        offload_stats.offloaded++;
+        offloaded = true;
+    }
+    else
+    {
+        offload_stats.fallbacks++;
+    }
+    xSemaphoreGive(submit_mutex);
+
+    if(!offloaded)
+    {
+        ipc_offload_execute_local(op, data, length, &completion);
+        callback(arg, handle, &completion);
+    }
+
+    return offloaded;
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_get_stats
+ *******************************************************************************
+ * Summary:
+ *  Returns the number of requests offloaded to CM55 and executed on CM33, and
+ *  the sessions and CPU load of each core.
+ *
+ * Parameters:
+ *  ipc_offload_stats_t *stats: Destination of the counters
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void ipc_offload_get_stats(ipc_offload_stats_t *stats)
+{
+    xSemaphoreTake(submit_mutex, portMAX_DELAY);
+    *stats = offload_stats;
+    xSemaphoreGive(submit_mutex);
+
+    stats->load[IPC_OFFLOAD_CORE_CM33] = core_load[IPC_OFFLOAD_CORE_CM33];
+    stats->load[IPC_OFFLOAD_CORE_CM55] = core_load[IPC_OFFLOAD_CORE_CM55];
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_load_callback
+ *******************************************************************************
+ * Summary:
+ *  Timer callback measuring the CPU load of both cores over the last period.
+ *  Both loads are shares of the wall-clock period rather than of the cycles
+ *  the core was awake: the DWT cycle counter stops in Deep Sleep, which a
+ *  lightly loaded core spends most of its time in.
+ *
+ * Parameters:
+ *  TimerHandle_t timer: Expired timer (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_load_callback(TimerHandle_t timer)
+{
+    uint32_t runtime = server_stats_runtime_counter();
+    uint32_t idle = ulTaskGetIdleRunTimeCounter();
+    uint32_t cm55_busy = cm55_busy_cycles;
+    uint32_t cm55_clock_hz = ipc_offload_shared.worker_clock_hz;
+    uint32_t period;
+    uint32_t load;
+
+    CY_UNUSED_PARAMETER(timer);
+
+    /* Run time units of CM33 in a period. */
+    period = ((SystemCoreClock / 1000U) * IPC_OFFLOAD_LOAD_PERIOD_MS) >>
+             SERVER_STATS_RUNTIME_SHIFT;
+    load = (uint32_t)(((uint64_t)((runtime - load_last_runtime) - (idle - load_last_idle)) *
+                       IPC_OFFLOAD_PERMILLE) / period);
+    core_load[IPC_OFFLOAD_CORE_CM33] = (load < IPC_OFFLOAD_PERMILLE) ? load : IPC_OFFLOAD_PERMILLE;
+
+    /* The clock of CM55 is only known once its worker runs. */
+    load = 0U;
+    if(0U != cm55_clock_hz)
+    {
+        load = (uint32_t)(((uint64_t)(cm55_busy - load_last_cm55_busy) * IPC_OFFLOAD_PERMILLE) /
+                          ((uint64_t)(cm55_clock_hz / 1000U) * IPC_OFFLOAD_LOAD_PERIOD_MS));
+    }
+    core_load[IPC_OFFLOAD_CORE_CM55] = (load < IPC_OFFLOAD_PERMILLE) ? load : IPC_OFFLOAD_PERMILLE;
+
+    load_last_runtime = runtime;
+    load_last_idle = idle;
+    load_last_cm55_busy = cm55_busy;
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_execute_local
+ *******************************************************************************
+ * Summary:
+ *  Executes a request on CM33.
+ *
+ * Parameters:
+ *  uint32_t op: Operation, one of ipc_offload_op_t
+ *  const uint8_t *data: Input
+ *  uint32_t length: Input length
+ *  ipc_offload_completion_t *completion: Outcome of the request
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_execute_local(uint32_t op, const uint8_t *data, uint32_t length,
+                                      ipc_offload_completion_t *completion)
+{
+    uint32_t start = cycle_counter_read();
+
+    completion->result = 0U;
+    completion->status = ipc_offload_execute(op, data, length, &completion->result);
+    completion->cycles = cycle_counter_read() - start;
+    completion->clock_hz = SystemCoreClock;
+    completion->offloaded = false;
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_completion_isr
+ *******************************************************************************
+ * Summary:
+ *  Completion doorbell interrupt handler. Releases the doorbell before waking
+ *  the completion task, so that a completion reported while the task drains
+ *  the ring rings the doorbell again.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_completion_isr(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    IPC_INTR_STRUCT_Type *intr_base = Cy_IPC_Drv_GetIntrBaseAddr(IPC_OFFLOAD_CPL_INTR);
+
+    Cy_IPC_Drv_ClearInterrupt(intr_base, CY_IPC_NO_NOTIFICATION,
+                              1UL << IPC_OFFLOAD_CPL_CHANNEL);
+    (void)Cy_IPC_Drv_LockRelease(Cy_IPC_Drv_GetIpcBaseAddress(IPC_OFFLOAD_CPL_CHANNEL),
+                                 CY_IPC_NO_NOTIFICATION);
+
+    vTaskNotifyGiveFromISR(completion_task_handle, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_completion_task
+ *******************************************************************************
+ * Summary:
+ *  Runs the callbacks of the descriptors CM55 completed, in submission order,
+ *  and returns the descriptors to the submitters.
+ *
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_completion_task(void *arg)
+{
+    ipc_offload_completion_t completion;
+    ipc_offload_pending_t *request;
+    ipc_offload_desc_t *desc;
+    uint32_t tail;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while(true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        tail = ipc_offload_shared.tail.value;
+        while(tail != ipc_offload_shared.done.value)
+        {
+            /* Read the descriptor only after observing the completion. */
+            __DMB();
+            desc = &ipc_offload_shared.desc[tail & IPC_OFFLOAD_DESC_MASK];
+            request = &pending[tail & IPC_OFFLOAD_DESC_MASK];
+
+            completion.status = desc->status;
+            completion.result = desc->result;
+            completion.cycles = desc->cycles;
+            completion.clock_hz = ipc_offload_shared.worker_clock_hz;
+            completion.offloaded = true;
+            cm55_busy_cycles += completion.cycles;
+            request->callback(request->arg, request->handle, &completion);
+
+            /* Return the descriptor only after it has been read. */
+            __DMB();
+            tail++;
+            ipc_offload_shared.tail.value = tail;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_benchmark_callback
+ *******************************************************************************
+ * Summary:
+ *  Completion callback of the benchmark. Keeps the outcome and wakes the
+ *  benchmark.
+ *
+ * Parameters:
+ *  void *arg: Semaphore given on completion
+ *  void *handle: Destination of the outcome
+ *  const ipc_offload_completion_t *completion: Outcome of the request
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_benchmark_callback(void *arg, void *handle,
+                                           const ipc_offload_completion_t *completion)
+{
+    *(ipc_offload_completion_t *)handle = *completion;
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_benchmark
+ *******************************************************************************
+ * Summary:
+ *  Times every supported operation over a range of input sizes, executed on
+ *  CM33 and offloaded to CM55, and prints the average execution time on
+ *  each core and the average round trip of an offloaded request as seen by
+ *  CM33.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void ipc_offload_benchmark(void)
+{
+    static const uint32_t sizes[] = { 64U, 256U, IPC_OFFLOAD_MIN_LEN, IPC_OFFLOAD_MAX_DATA_LEN };
+    static uint8_t input[IPC_OFFLOAD_MAX_DATA_LEN];
+    ipc_offload_completion_t completion;
+    SemaphoreHandle_t completed;
+    uint64_t local_cycles;
+    uint64_t remote_cycles;
+    uint64_t round_trip_cycles;
+    uint32_t remote_count;
+    uint32_t remote_clock_hz = 0U;
+    uint32_t start;
+    uint32_t size;
+    uint32_t iteration;
+
+    completed = xSemaphoreCreateBinary();
+    if(NULL == completed)
+    {
+        return;
+    }
+
+    for(iteration = 0; iteration < sizeof(input); iteration++)
+    {
+        input[iteration] = (uint8_t)iteration;
+    }
+
+    printf("IPC offload benchmark, %u iterations per size (CM55 %s)\n",
+            IPC_OFFLOAD_BENCHMARK_ITERATIONS,
+            (IPC_OFFLOAD_MAGIC == ipc_offload_shared.worker_ready) ? "ready" : "not running");
+
+    for(size = 0; size < (sizeof(sizes) / sizeof(sizes[0])); size++)
+    {
+        local_cycles = 0U;
+        remote_cycles = 0U;
+        round_trip_cycles = 0U;
+        remote_count = 0U;
+
+        for(iteration = 0; iteration < IPC_OFFLOAD_BENCHMARK_ITERATIONS; iteration++)
+        {
+            ipc_offload_execute_local(IPC_OFFLOAD_OP_CRC32, input, sizes[size], &completion);
+            local_cycles += completion.cycles;
+
+            start = cycle_counter_read();
+            (void)ipc_offload_dispatch(IPC_OFFLOAD_OP_CRC32, input, sizes[size], 0U,
+                                       ipc_offload_benchmark_callback, completed, &completion);
+            xSemaphoreTake(completed, portMAX_DELAY);
+            if(completion.offloaded)
+            {
+                round_trip_cycles += cycle_counter_read() - start;
+                remote_cycles += completion.cycles;
+                remote_clock_hz = completion.clock_hz;
+                remote_count++;
+            }
+        }
+
+        printf("CRC-32 of %4"PRIu32" bytes: CM33 %"PRIu32" ns", sizes[size],
+                (uint32_t)((local_cycles * 1000000000ULL) /
+                           ((uint64_t)SystemCoreClock * IPC_OFFLOAD_BENCHMARK_ITERATIONS)));
+        if((0U != remote_count) && (0U != remote_clock_hz))
+        {
+            printf(", CM55 %"PRIu32" ns, round trip %"PRIu32" ns\n",
+                    (uint32_t)((remote_cycles * 1000000000ULL) /
+                               ((uint64_t)remote_clock_hz * remote_count)),
+                    (uint32_t)((round_trip_cycles * 1000000000ULL) /
+                               ((uint64_t)SystemCoreClock * remote_count)));
+        }
+        else
+        {
+            printf(", not offloaded\n");
+        }
+    }
+
+    printf("Requests below %u bytes are executed on CM33 (IPC_OFFLOAD_MIN_LEN)\n",
+            IPC_OFFLOAD_MIN_LEN);
+
+    vSemaphoreDelete(completed);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,160 @@
+/******************************************************************************
+* File Name:   ipc_offload.h
+*
+* Description: This file is the public interface of ipc_offload.c, the
+* CM33 side of the IPC pipeline offloading frame processing to CM55.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_OFFLOAD_H_
+#define IPC_OFFLOAD_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_result.h"
+
+/* Shared-memory layout of the IPC pipeline */
+#include "ipc_offload_shared.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Requests are executed on CM33 instead of being queued once this many are
+ * waiting for CM55. At most IPC_OFFLOAD_DESC_COUNT. */
+#define IPC_OFFLOAD_MAX_INFLIGHT                  (IPC_OFFLOAD_DESC_COUNT)
+
+/* Requests with less input than this are executed on CM33: below it the IPC
+ * round trip costs CM33 more than the operation itself. The default is the
+ * break-even of the CRC-32 measured with IPC_OFFLOAD_BENCHMARK_ENABLE, which
+ * is close to the largest DATA frame; measure again when the operation or
+ * the clocks change. */
+#define IPC_OFFLOAD_MIN_LEN                       (510U)
+
+/* Interrupt of the completion doorbell. Must match IPC_OFFLOAD_CPL_INTR. */
+#ifndef IPC_OFFLOAD_CPL_IRQ
+#define IPC_OFFLOAD_CPL_IRQ                       ((IRQn_Type)(m33syscpuss_interrupts_ipc_dpslp_0_IRQn + IPC_OFFLOAD_CPL_INTR))
+#endif
+#define IPC_OFFLOAD_CPL_IRQ_PRIORITY              (7U)
+
+/* Task running the completion callbacks. */
+#define IPC_OFFLOAD_TASK_STACK_SIZE               (1024U * 2U)
+#define IPC_OFFLOAD_TASK_PRIORITY                 (1U)
+
+/* Period over which the CPU load of each core is measured. Must be shorter
+ * than a wrap of the DWT cycle counter of either core. */
+#define IPC_OFFLOAD_LOAD_PERIOD_MS                (1000U)
+
+/* A new session goes to the core whose CPU load is lower by more than this
+ * margin, in permille, and otherwise to the core serving fewer sessions. The
+ * margin keeps small load fluctuations from outweighing the session count. */
+#define IPC_OFFLOAD_LOAD_MARGIN_PERMILLE          (100U)
+
+/* Set this macro to '1' to time every operation on CM33 and through CM55 at
+ * start-up and print the results. */
+#define IPC_OFFLOAD_BENCHMARK_ENABLE              (0U)
+#define IPC_OFFLOAD_BENCHMARK_ITERATIONS          (32U)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Cores that execute requests. */
+typedef enum
+{
+    IPC_OFFLOAD_CORE_CM33 = 0,
+    IPC_OFFLOAD_CORE_CM55,
+    IPC_OFFLOAD_CORE_COUNT
+} ipc_offload_core_t;
+
+/* Outcome of a request. cycles counts the cycles of the core that executed
+ * it, at clock_hz. */
+typedef struct
+{
+    uint32_t status;
+    uint32_t result;
+    uint32_t cycles;
+    uint32_t clock_hz;
+    bool offloaded;
+} ipc_offload_completion_t;
+
+/* Completion callback. Runs in the completion task for offloaded requests,
+ * and in the submitting task for requests executed on CM33. arg and handle
+ * are the values given to ipc_offload_submit(). */
+typedef void (*ipc_offload_callback_t)(void *arg, void *handle,
+                                       const ipc_offload_completion_t *completion);
+
+/* Request counters and per-core figures. fallbacks counts the requests
+ * executed on CM33, because their session is on CM33, they were below
+ * IPC_OFFLOAD_MIN_LEN or CM55 was not running or busy. sessions counts the
+ * sessions attached to each core, and load is the CPU load of each core in
+ * permille of the wall-clock time over the last IPC_OFFLOAD_LOAD_PERIOD_MS.
+ * The load of CM55 only counts the requests it executed, which is all the
+ * work it does. */
+typedef struct
+{
+    uint32_t offloaded;
+    uint32_t fallbacks;
+    uint32_t sessions[IPC_OFFLOAD_CORE_COUNT];
+    uint32_t load[IPC_OFFLOAD_CORE_COUNT];
+} ipc_offload_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t ipc_offload_init(void);
+ipc_offload_core_t ipc_offload_attach(void);
+void ipc_offload_detach(ipc_offload_core_t core);
+bool ipc_offload_submit(ipc_offload_core_t core, uint32_t op, const uint8_t *data,
+                        uint32_t length, ipc_offload_callback_t callback, void *arg,
+                        void *handle);
+void ipc_offload_get_stats(ipc_offload_stats_t *stats);
+void ipc_offload_benchmark(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* IPC_OFFLOAD_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,147 @@
+/******************************************************************************
+* File Name:   isr_event_ring.c
+*
+* Description: This file contains a lock-free single-producer/
+* single-consumer event ring. Events are never overwritten: when the ring is
+* full the new event is counted as dropped.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+#include "isr_event_ring.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define ISR_EVENT_RING_MASK                            (ISR_EVENT_RING_SIZE - 1U)
+
+#if ((ISR_EVENT_RING_SIZE & ISR_EVENT_RING_MASK) != 0U)
+#error "ISR_EVENT_RING_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+ * Function Name: isr_event_ring_push
+ *******************************************************************************
+ * Summary:
+ *  Adds an event to the ring. Must only be called by the single producer.
+ *
+ * Parameters:
+ *  isr_event_ring_t *ring: Event ring
+ *  uint32_t value: Event value
+ *  uint32_t timestamp: Time at which the event occurred
+ *
+ * Return:
+ *  bool: false if the ring was full and the event was dropped.
+ *
+ *******************************************************************************/
+bool isr_event_ring_push(isr_event_ring_t *ring, uint32_t value, uint32_t timestamp)
+{
+    uint32_t head = ring->head;
+    isr_event_t *event;
+
+    if((head - ring->tail) >= ISR_EVENT_RING_SIZE)
+    {
+        ring->dropped++;
+        return false;
+    }
+
+    event = &ring->events[head & ISR_EVENT_RING_MASK];
+    event->timestamp = timestamp;
+    event->value = value;
+
+    /* Publish the slot only after it has been written. */
+    __DMB();
+    ring->head = head + 1U;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: isr_event_ring_pop
+ *******************************************************************************
+ * Summary:
+ *  Takes the oldest event from the ring. Must only be called by the single
+ *  consumer.
+ *
+ * Parameters:
+ *  isr_event_ring_t *ring: Event ring
+ *  isr_event_t *event: Destination of the event
+ *
+ * Return:
+ *  bool: false if the ring was empty.
+ *
+ *******************************************************************************/
+bool isr_event_ring_pop(isr_event_ring_t *ring, isr_event_t *event)
+{
+    uint32_t tail = ring->tail;
+
+    if(tail == ring->head)
+    {
+        return false;
+    }
+
+    /* Read the slot only after observing the head that published it. */
+    __DMB();
+    *event = ring->events[tail & ISR_EVENT_RING_MASK];
+
+    /* Release the slot only after it has been read. */
+    __DMB();
+    ring->tail = tail + 1U;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: isr_event_ring_dropped
+ *******************************************************************************
+ * Summary:
+ *  Returns the number of events dropped because the ring was full.
+ *
+ * Parameters:
+ *  const isr_event_ring_t *ring: Event ring
+ *
+ * Return:
+ *  uint32_t: Number of dropped events.
+ *
+ *******************************************************************************/
+uint32_t isr_event_ring_dropped(const isr_event_ring_t *ring)
+{
+    return ring->dropped;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name:   isr_event_ring.h
+*
+* Description: This file is the public interface of isr_event_ring.c, a
+* lock-free single-producer/single-consumer event ring used to hand events
+* from an interrupt handler to a task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ISR_EVENT_RING_H_
+#define ISR_EVENT_RING_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Number of events the ring holds. Must be a power of two. */
+#define ISR_EVENT_RING_SIZE                       (32U)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Event carried from the interrupt handler to the task. */
+typedef struct
+{
+    uint32_t timestamp;
+    uint32_t value;
+} isr_event_t;
+
+/* Event ring. head is only written by the producer (the interrupt handler)
+ * and tail only by the consumer (the task); both run freely and are reduced
+ * modulo ISR_EVENT_RING_SIZE when indexing the slots.
+ */
+typedef struct
+{
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t dropped;
+    isr_event_t events[ISR_EVENT_RING_SIZE];
+} isr_event_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+bool isr_event_ring_push(isr_event_ring_t *ring, uint32_t value, uint32_t timestamp);
+bool isr_event_ring_pop(isr_event_ring_t *ring, isr_event_t *event);
+uint32_t isr_event_ring_dropped(const isr_event_ring_t *ring);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* ISR_EVENT_RING_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name:   lwipopts.h
+*
+* Description: This file is the lwIP configuration of the secure TCP server. It
+* * takes the configuration of the ethernet-core-freertos-lwip-mbedtls
+* * library and resizes its pools and windows for the network memory profile
+* * selected in net_profile.h.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef APP_LWIPOPTS_H_
+#define APP_LWIPOPTS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+
+/* The configuration of the library. This file is found ahead of it as
+ * "lwipopts.h" because the include paths of the application come before those
+ * of the libraries. */
+#include "configs/lwipopts.h"
+#include "net_profile.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Application marker, checked by net_profile.c so that a build that picks up
+ * the library configuration instead of this file fails. */
+#define APP_LWIPOPTS_IN_USE                       (1U)
+
+#if (NET_PROFILE_DEFAULT != NET_PROFILE)
+
+#undef MEMP_NUM_TCP_PCB
+#define MEMP_NUM_TCP_PCB                          (NET_PROFILE_TCP_PCBS)
+
+#undef MEMP_NUM_NETCONN
+#define MEMP_NUM_NETCONN                          (NET_PROFILE_NETCONNS)
+
+#undef TCP_MSS
+#define TCP_MSS                                   (1460)
+
+#undef TCP_WND
+#define TCP_WND                                   (NET_PROFILE_TCP_WND_SEGMENTS * TCP_MSS)
+
+#undef TCP_SND_BUF
+#define TCP_SND_BUF                               (NET_PROFILE_TCP_SND_BUF_SEGMENTS * TCP_MSS)
+
+/* Four pbufs per segment of the send buffer; lwIP requires at least two. */
+#undef TCP_SND_QUEUELEN
+#define TCP_SND_QUEUELEN                          ((4 * TCP_SND_BUF) / TCP_MSS)
+
+#undef MEMP_NUM_TCP_SEG
+#define MEMP_NUM_TCP_SEG                          (NET_PROFILE_TCP_SEGS)
+
+#undef PBUF_POOL_SIZE
+#define PBUF_POOL_SIZE                            (NET_PROFILE_PBUF_POOL_SIZE)
+
+#undef MEM_SIZE
+#define MEM_SIZE                                  (NET_PROFILE_MEM_SIZE)
+
+#endif /* (NET_PROFILE_DEFAULT != NET_PROFILE) */
+
+/* Pool statistics, from which the server reports the most pbufs, PCBs and
+ * segments ever in use. */
+#undef LWIP_STATS
+#define LWIP_STATS                                (1)
+#undef MEM_STATS
+#define MEM_STATS                                 (1)
+#undef MEMP_STATS
+#define MEMP_STATS                                (1)
+#undef LWIP_STATS_DISPLAY
+#define LWIP_STATS_DISPLAY                        (0)
+
+#endif /* APP_LWIPOPTS_H_ */
+
+/* [] END OF FILE */
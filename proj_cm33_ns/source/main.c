@@ -54,13 +54,22 @@
 /* Secure TCP client task header file. */
 #include "secure_tcp_server.h"
 
+/* Deferred logger header file */
+#include "app_log.h"
+
+/* CM55 offload pipeline header file */
+#include "ipc_offload.h"
+
+/* Start-up timeline header file */
+#include "boot_timeline.h"
+
 
 /******************************************************************************
 * Macros
 ******************************************************************************/
 /* RTOS related macros for TCP server task */
 #define TCP_SECURE_SERVER_TASK_STACK_SIZE  (1024U * 5U)
-#define TCP_SECURE_SERVER_TASK_PRIORITY    (1U)
+#define TCP_SECURE_SERVER_TASK_PRIORITY    (3U)
 
 /* The timeout value in microsecond used to wait for the CM55 core to be booted.
  * Use value 0U for infinite wait till the core is booted successfully.
@@ -243,6 +252,9 @@ int main(void)
         handle_app_error();
     }
 
+    /* Start the start-up timeline now that the clocks are configured. */
+    boot_timeline_init();
+
     /* Setup CLIB support library. */
     setup_clib_support();
 
@@ -261,15 +273,29 @@ int main(void)
     printf("             PSOC Edge MCU: Ethernet Secure TCP Server             \n");
     printf("===============================================================\n\n");
 
+    /* Set up the offload pipeline before CM55 starts looking for it. */
+    if(CY_RSLT_SUCCESS != ipc_offload_init())
+    {
+        handle_app_error();
+    }
+
     /* Enable CM55. CM55_APP_BOOT_ADDR must be updated if CM55 memory layout is changed. */
     Cy_SysEnableCM55(MXCM55, CM55_APP_BOOT_ADDR, CM55_BOOT_WAIT_TIME_USEC);
 
+    /* Create the task printing the deferred log records. */
+    if(CY_RSLT_SUCCESS != app_log_init())
+    {
+        handle_app_error();
+    }
+
     /* Create the tasks */
     result = xTaskCreate(tcp_secure_server_task, "Network task", TCP_SECURE_SERVER_TASK_STACK_SIZE,
                 NULL, TCP_SECURE_SERVER_TASK_PRIORITY, &server_task_handle);
 
     if( pdPASS == result )
     {
+        boot_timeline_mark("Scheduler starting");
+
         /* Start the FreeRTOS scheduler. */
         vTaskStartScheduler();
 
@@ -0,0 +1,282 @@
+/******************************************************************************
+* File Name:   mem_pool.c
+*
+* Description: This file contains the fixed-block pools serving the mbedTLS
+* allocations of the secure TCP server. The TLS contexts and record buffers
+* of every connection come from pools sized at build time, so that accepting
+* a client never depends on the state of the heap.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* Standard C header files */
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* mbedTLS header file */
+#include "mbedtls/platform.h"
+
+/* Secure TCP server header file, for the client and worker counts */
+#include "secure_tcp_server.h"
+
+/* Runtime performance counters header file */
+#include "server_stats.h"
+
+/* Memory pool header file */
+#include "mem_pool.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Number of pools, from the smallest blocks to the largest. */
+#define MEM_POOL_COUNT                                 (5U)
+
+_Static_assert((MEM_POOL_SMALL_BLOCK_SIZE % MEM_POOL_ALIGNMENT) == 0U,
+               "Pool blocks must keep the alignment");
+_Static_assert((MEM_POOL_MEDIUM_BLOCK_SIZE % MEM_POOL_ALIGNMENT) == 0U,
+               "Pool blocks must keep the alignment");
+_Static_assert((MEM_POOL_LARGE_BLOCK_SIZE % MEM_POOL_ALIGNMENT) == 0U,
+               "Pool blocks must keep the alignment");
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Free block, linked through its first word. */
+typedef struct mem_pool_block
+{
+    struct mem_pool_block *next;
+} mem_pool_block_t;
+
+/* Pool of blocks of one size, carved from a static array. */
+typedef struct
+{
+    uint8_t *base;
+    uint32_t block_size;
+    uint32_t block_count;
+    mem_pool_block_t *free_list;
+    uint32_t in_use;
+    server_stats_hwm_t hwm;
+} mem_pool_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+#if (MEM_POOL_ENABLE)
+/* Block storage of every pool. */
+static uint64_t mem_pool_small_storage[(MEM_POOL_SMALL_BLOCK_SIZE * MEM_POOL_SMALL_BLOCK_COUNT) /
+                                       sizeof(uint64_t)];
+static uint64_t mem_pool_medium_storage[(MEM_POOL_MEDIUM_BLOCK_SIZE * MEM_POOL_MEDIUM_BLOCK_COUNT) /
+                                        sizeof(uint64_t)];
+static uint64_t mem_pool_large_storage[(MEM_POOL_LARGE_BLOCK_SIZE * MEM_POOL_LARGE_BLOCK_COUNT) /
+                                       sizeof(uint64_t)];
+static uint64_t mem_pool_record_out_storage[(MEM_POOL_RECORD_OUT_BLOCK_SIZE *
+                                             MEM_POOL_RECORD_OUT_BLOCK_COUNT) / sizeof(uint64_t)];
+static uint64_t mem_pool_record_in_storage[(MEM_POOL_RECORD_IN_BLOCK_SIZE *
+                                            MEM_POOL_RECORD_IN_BLOCK_COUNT) / sizeof(uint64_t)];
+
+/* Pools, from the smallest blocks to the largest. */
+static mem_pool_t mem_pools[MEM_POOL_COUNT] =
+{
+    { (uint8_t *)mem_pool_small_storage, MEM_POOL_SMALL_BLOCK_SIZE,
+      MEM_POOL_SMALL_BLOCK_COUNT, NULL, 0U, SERVER_STATS_HWM_POOL_SMALL },
+    { (uint8_t *)mem_pool_medium_storage, MEM_POOL_MEDIUM_BLOCK_SIZE,
+      MEM_POOL_MEDIUM_BLOCK_COUNT, NULL, 0U, SERVER_STATS_HWM_POOL_MEDIUM },
+    { (uint8_t *)mem_pool_large_storage, MEM_POOL_LARGE_BLOCK_SIZE,
+      MEM_POOL_LARGE_BLOCK_COUNT, NULL, 0U, SERVER_STATS_HWM_POOL_LARGE },
+    { (uint8_t *)mem_pool_record_out_storage, MEM_POOL_RECORD_OUT_BLOCK_SIZE,
+      MEM_POOL_RECORD_OUT_BLOCK_COUNT, NULL, 0U, SERVER_STATS_HWM_POOL_RECORD_OUT },
+    { (uint8_t *)mem_pool_record_in_storage, MEM_POOL_RECORD_IN_BLOCK_SIZE,
+      MEM_POOL_RECORD_IN_BLOCK_COUNT, NULL, 0U, SERVER_STATS_HWM_POOL_RECORD_IN }
+};
+#endif /* MEM_POOL_ENABLE */
+
+/*******************************************************************************
+ * Function Name: mem_pool_init
+ *******************************************************************************
+ * Summary:
+ *  Links the blocks of every pool into its free list and makes mbedTLS
+ *  allocate from the pools. Blocks that mbedTLS allocated from the heap
+ *  before this call are still returned to the heap.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_rslt_t: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t mem_pool_init(void)
+{
+#if (MEM_POOL_ENABLE)
+    mem_pool_t *pool;
+    mem_pool_block_t *free_block;
+    uint32_t index;
+    uint32_t block;
+
+    for(index = 0; index < MEM_POOL_COUNT; index++)
+    {
+        pool = &mem_pools[index];
+        pool->free_list = NULL;
+        for(block = pool->block_count; block > 0U; block--)
+        {
+            free_block = (mem_pool_block_t *)&pool->base[(block - 1U) * pool->block_size];
+            free_block->next = pool->free_list;
+            pool->free_list = free_block;
+        }
+    }
+
+    if(0 != mbedtls_platform_set_calloc_free(mem_pool_calloc, mem_pool_free))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+#endif /* MEM_POOL_ENABLE */
+
+    return CY_RSLT_SUCCESS;
+}
+
+#if (MEM_POOL_ENABLE)
+/*******************************************************************************
+ * Function Name: mem_pool_calloc
+ *******************************************************************************
+ * Summary:
+ *  Allocates a zeroed block from the smallest pool with a free block the
+ *  request fits in, or from the heap if there is none. Safe to call from any
+ *  task.
+ *
+ * Parameters:
+ *  size_t count: Number of elements
+ *  size_t size: Size of an element
+ *
+ * Return:
+ *  void *: The allocated memory, or NULL if none is left.
+ *
+ *******************************************************************************/
+void *mem_pool_calloc(size_t count, size_t size)
+{
+    mem_pool_t *pool;
+    mem_pool_block_t *block = NULL;
+    uint32_t in_use = 0U;
+    uint32_t index;
+    size_t length;
+
+    if((0U != size) && (count > (SIZE_MAX / size)))
+    {
+        return NULL;
+    }
+    length = count * size;
+
+    taskENTER_CRITICAL();
+    for(index = 0; index < MEM_POOL_COUNT; index++)
+    {
+        pool = &mem_pools[index];
+        if((length <= pool->block_size) && (NULL != pool->free_list))
+        {
+            block = pool->free_list;
+            pool->free_list = block->next;
+            in_use = ++pool->in_use;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if(NULL == block)
+    {
+        server_stats_add(SERVER_STATS_POOL_FALLBACKS, 1U);
+        return calloc(count, size);
+    }
+
+    server_stats_track(pool->hwm, in_use);
+    memset(block, 0, length);
+
+    return block;
+}
+
+/*******************************************************************************
+ * Function Name: mem_pool_free
+ *******************************************************************************
+ * Summary:
+ *  Returns memory allocated by mem_pool_calloc() to its pool, or to the heap
+ *  if it did not come from a pool. Safe to call from any task.
+ *
+ * Parameters:
+ *  void *ptr: Memory to free, or NULL
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void mem_pool_free(void *ptr)
+{
+    mem_pool_t *pool;
+    mem_pool_block_t *block = (mem_pool_block_t *)ptr;
+    uint32_t index;
+
+    if(NULL == ptr)
+    {
+        return;
+    }
+
+    for(index = 0; index < MEM_POOL_COUNT; index++)
+    {
+        pool = &mem_pools[index];
+        if(((uint8_t *)ptr >= pool->base) &&
+           ((uint8_t *)ptr < &pool->base[pool->block_count * pool->block_size]))
+        {
+            taskENTER_CRITICAL();
+            block->next = pool->free_list;
+            pool->free_list = block;
+            pool->in_use--;
+            taskEXIT_CRITICAL();
+            return;
+        }
+    }
+
+    free(ptr);
+}
+#endif /* MEM_POOL_ENABLE */
+
+/* [] END OF FILE */
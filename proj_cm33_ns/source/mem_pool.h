@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name:   mem_pool.h
+*
+* Description: This file is the public interface of mem_pool.c, the fixed-block
+* pools serving the mbedTLS allocations of the secure TCP server.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef MEM_POOL_H_
+#define MEM_POOL_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_result.h"
+#include "mbedtls/ssl.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Set from the Makefile with MEM_POOL. When 1, the allocations of mbedTLS
+ * are served from the pools below instead of the heap. */
+#ifndef MEM_POOL_ENABLE
+#define MEM_POOL_ENABLE                           (0U)
+#endif
+
+/* Block size and count of every pool. An allocation takes a block of the
+ * smallest pool it fits in, or of the next larger pool if that one is
+ * exhausted, and falls back to the heap if no pool has a free block. The
+ * counts scale with the number of clients, which hold their TLS context and
+ * record buffers for the lifetime of the session, and with the number of
+ * handshake workers, which need the most blocks while negotiating. */
+#define MEM_POOL_SMALL_BLOCK_SIZE                 (64U)
+#define MEM_POOL_SMALL_BLOCK_COUNT                ((16U * TCP_SERVER_MAX_CLIENTS) + \
+                                                   (32U * TCP_SERVER_HANDSHAKE_WORKERS))
+#define MEM_POOL_MEDIUM_BLOCK_SIZE                (256U)
+#define MEM_POOL_MEDIUM_BLOCK_COUNT               ((4U * TCP_SERVER_MAX_CLIENTS) + \
+                                                   (8U * TCP_SERVER_HANDSHAKE_WORKERS))
+#define MEM_POOL_LARGE_BLOCK_SIZE                 (2048U)
+#define MEM_POOL_LARGE_BLOCK_COUNT                ((2U * TCP_SERVER_MAX_CLIENTS) + \
+                                                   (4U * TCP_SERVER_HANDSHAKE_WORKERS))
+
+/* TLS record buffers: one output and one input buffer per client, sized
+ * from the record content lengths mbedTLS is built with (set from the
+ * Makefile with TLS_OUT_RECORD_LEN and TLS_IN_RECORD_LEN). The blocks leave
+ * room for the record header, IV, MAC and padding around the content. The
+ * output pool comes first, as a server usually sends shorter records than
+ * the largest it accepts. */
+#define MEM_POOL_RECORD_OVERHEAD                  (512U)
+
+/* Alignment of the blocks, enough for any type mbedTLS allocates. */
+#define MEM_POOL_ALIGNMENT                        (8U)
+#define MEM_POOL_ALIGN(size)                      (((size) + MEM_POOL_ALIGNMENT - 1U) & \
+                                                   ~(MEM_POOL_ALIGNMENT - 1U))
+#define MEM_POOL_RECORD_OUT_BLOCK_SIZE            MEM_POOL_ALIGN(MBEDTLS_SSL_OUT_CONTENT_LEN + \
+                                                                 MEM_POOL_RECORD_OVERHEAD)
+#define MEM_POOL_RECORD_OUT_BLOCK_COUNT           (TCP_SERVER_MAX_CLIENTS)
+#define MEM_POOL_RECORD_IN_BLOCK_SIZE             MEM_POOL_ALIGN(MBEDTLS_SSL_IN_CONTENT_LEN + \
+                                                                 MEM_POOL_RECORD_OVERHEAD)
+#define MEM_POOL_RECORD_IN_BLOCK_COUNT            (TCP_SERVER_MAX_CLIENTS)
+
+/* Largest record content of TLS, the record buffer size of mbedTLS when it
+ * is not configured otherwise. */
+#define MEM_POOL_TLS_MAX_CONTENT_LEN              (16384U)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t mem_pool_init(void);
+void *mem_pool_calloc(size_t count, size_t size);
+void mem_pool_free(void *ptr);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* MEM_POOL_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,123 @@
+/******************************************************************************
+* File Name:   net_profile.c
+*
+* Description: This file reports the network memory profile of the secure TCP
+* * server: the lwIP pool sizes it was built with, the static RAM they take
+* * and the most of each pool ever in use.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "net_profile.h"
+
+/* Standard C header files */
+#include <stdio.h>
+#include <inttypes.h>
+
+/* lwIP header files */
+#include "lwip/opt.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+
+/* Server statistics header file */
+#include "server_stats.h"
+
+#if !defined(APP_LWIPOPTS_IN_USE)
+#error "lwIP is not built with the lwipopts.h of the application"
+#endif
+
+/*******************************************************************************
+ * Function Name: net_profile_report
+ *******************************************************************************
+ * Summary:
+ *  Prints the network memory profile, the TCP window and send buffer it sets,
+ *  and the static RAM taken by the lwIP pools and heap.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void net_profile_report(void)
+{
+    uint32_t pools = 0U;
+    uint32_t index;
+
+#if !MEMP_MEM_MALLOC
+    for(index = 0U; index < (uint32_t)MEMP_MAX; index++)
+    {
+        pools += (uint32_t)memp_pools[index]->size * memp_pools[index]->num;
+    }
+#else
+    (void)index;
+#endif
+
+    printf("Network profile: %s\n", NET_PROFILE_NAME);
+    printf("lwIP: %"PRIu32" TCP PCBs, %"PRIu32" segments, %"PRIu32" pbufs of %"PRIu32" bytes, "
+           "window %"PRIu32" bytes, send buffer %"PRIu32" bytes\n",
+           (uint32_t)MEMP_NUM_TCP_PCB, (uint32_t)MEMP_NUM_TCP_SEG, (uint32_t)PBUF_POOL_SIZE,
+           (uint32_t)PBUF_POOL_BUFSIZE, (uint32_t)TCP_WND, (uint32_t)TCP_SND_BUF);
+    printf("lwIP memory: %"PRIu32" bytes (%"PRIu32" of pools, %"PRIu32" of heap)\n",
+           pools + (uint32_t)MEM_SIZE, pools, (uint32_t)MEM_SIZE);
+}
+
+/*******************************************************************************
+ * Function Name: net_profile_track
+ *******************************************************************************
+ * Summary:
+ *  Copies the most pbufs, TCP PCBs and TCP segments ever in use, and the
+ *  largest use of the lwIP heap, into the high-water marks of the server
+ *  statistics. Called before every statistics snapshot.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void net_profile_track(void)
+{
+    server_stats_track(SERVER_STATS_HWM_PBUF_POOL, memp_pools[MEMP_PBUF_POOL]->stats->max);
+    server_stats_track(SERVER_STATS_HWM_TCP_PCB, memp_pools[MEMP_TCP_PCB]->stats->max);
+    server_stats_track(SERVER_STATS_HWM_TCP_SEG, memp_pools[MEMP_TCP_SEG]->stats->max);
+    server_stats_track(SERVER_STATS_HWM_LWIP_HEAP, (uint32_t)lwip_stats.mem.max);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name:   net_profile.h
+*
+* Description: This file selects the network memory profile of the secure TCP
+* * server: the lwIP pool and window sizes applied by lwipopts.h, and the
+* * functions that report them.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef NET_PROFILE_H_
+#define NET_PROFILE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Network memory profiles, set from the Makefile with NET_PROFILE. The
+ * windows and send buffers are given in full-sized segments of TCP_MSS
+ * bytes. */
+
+/* The lwIP configuration of the ethernet-core-freertos-lwip-mbedtls library,
+ * unchanged. */
+#define NET_PROFILE_DEFAULT                       (0U)
+
+/* Smallest pools and windows for a single client, to leave the most SRAM to
+ * the application. */
+#define NET_PROFILE_LOW_RAM                       (1U)
+
+/* Pools and windows sized for TCP_SERVER_MAX_CLIENTS clients streaming at
+ * the same time. */
+#define NET_PROFILE_MULTI_CLIENT                  (2U)
+
+#ifndef NET_PROFILE
+#define NET_PROFILE                               (NET_PROFILE_DEFAULT)
+#endif
+
+#if (NET_PROFILE_LOW_RAM == NET_PROFILE)
+#define NET_PROFILE_NAME                          "low-RAM single client"
+#define NET_PROFILE_TCP_PCBS                      (2U)
+#define NET_PROFILE_NETCONNS                      (4U)
+#define NET_PROFILE_TCP_WND_SEGMENTS              (2U)
+#define NET_PROFILE_TCP_SND_BUF_SEGMENTS          (2U)
+#define NET_PROFILE_TCP_SEGS                      (8U)
+#define NET_PROFILE_PBUF_POOL_SIZE                (8U)
+#define NET_PROFILE_MEM_SIZE                      (8U * 1024U)
+#elif (NET_PROFILE_MULTI_CLIENT == NET_PROFILE)
+#define NET_PROFILE_NAME                          "high-throughput multi-client"
+/* One PCB per client, plus the connections still in TIME_WAIT after a
+ * reconnect. */
+#define NET_PROFILE_TCP_PCBS                      (8U)
+#define NET_PROFILE_NETCONNS                      (12U)
+#define NET_PROFILE_TCP_WND_SEGMENTS              (4U)
+#define NET_PROFILE_TCP_SND_BUF_SEGMENTS          (4U)
+/* A full send queue for every client. */
+#define NET_PROFILE_TCP_SEGS                      (64U)
+#define NET_PROFILE_PBUF_POOL_SIZE                (32U)
+#define NET_PROFILE_MEM_SIZE                      (32U * 1024U)
+#elif (NET_PROFILE_DEFAULT == NET_PROFILE)
+#define NET_PROFILE_NAME                          "library default"
+#else
+#error "NET_PROFILE must be 0 (default), 1 (low-RAM) or 2 (multi-client)"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void net_profile_report(void);
+void net_profile_track(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* NET_PROFILE_H_ */
+
+/* [] END OF FILE */
@@ -54,6 +54,13 @@ extern "C" {
 * Macros
 ********************************************************************************/
 
+/* Set to 1 by the Makefile (TLS_CREDENTIALS_FORMAT=DER) to load the DER form
+ * of the credentials below, which scripts/pem_to_der.py generates at build
+ * time, instead of decoding the PEM strings at start-up. */
+#ifndef TLS_CREDENTIALS_DER
+#define TLS_CREDENTIALS_DER                       (0)
+#endif
+
 /* TCP server certificate. Copy from the TCP server certificate
  * generated by OpenSSL (See Readme.md on how to generate a SSL certificate).
  */
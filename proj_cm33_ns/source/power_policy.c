@@ -0,0 +1,370 @@
+/******************************************************************************
+* File Name:   power_policy.c
+*
+* Description: This file implements the power policy: a SysPm callback that holds off
+* * Deep Sleep while clients are connected in the low-latency policy, and the
+* * measurement of the wake-up to response latency of every policy.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+#include "power_policy.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* Standard C header files */
+#include <stdbool.h>
+#include <string.h>
+
+/* Cycle counter header file */
+#include "cycle_counter.h"
+
+/* Shared application state header file, for the number of clients */
+#include "app_state.h"
+
+/* Session table header file, for the transmit batches */
+#include "tcp_session.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Check the policy before the other Deep Sleep callbacks prepare their
+ * peripherals. */
+#define POWER_POLICY_CALLBACK_ORDER               (0U)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Running sums of a policy. */
+typedef struct
+{
+    uint32_t responses;
+    uint64_t latency_cycles;
+    uint32_t latency_max_cycles;
+    uint32_t deep_sleeps;
+    uint32_t deep_sleeps_held_off;
+} power_policy_counts_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static cy_en_syspm_status_t power_policy_deepsleep_callback(
+    cy_stc_syspm_callback_params_t *callback_params, cy_en_syspm_callback_mode_t mode);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static volatile power_policy_t power_policy = POWER_POLICY_DEFAULT;
+static power_policy_counts_t power_policy_counts[POWER_POLICY_COUNT];
+
+/* Whether the CPU left Deep Sleep and no wake source interrupt ran since. */
+static volatile bool power_policy_woke;
+
+/* Cycle count at the interrupt of the last wake source, and whether a
+ * request has been timed from it yet. */
+static volatile uint32_t power_policy_wake_cycles;
+static volatile bool power_policy_wake_pending;
+
+static cy_stc_syspm_callback_params_t power_policy_callback_params =
+{
+    .context            = NULL,
+    .base               = NULL
+};
+
+static cy_stc_syspm_callback_t power_policy_callback =
+{
+    .callback           = &power_policy_deepsleep_callback,
+    .skipMode           = 0U,
+    .type               = CY_SYSPM_DEEPSLEEP,
+    .callbackParams     = &power_policy_callback_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = POWER_POLICY_CALLBACK_ORDER
+};
+
+/*******************************************************************************
+ * Function Name: power_policy_init
+ *******************************************************************************
+ * Summary:
+ *  Registers the Deep Sleep callback that applies the policy.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_rslt_t: CY_RSLT_SUCCESS, or CY_RSLT_TYPE_ERROR if the callback could
+ *  not be registered.
+ *
+ *******************************************************************************/
+cy_rslt_t power_policy_init(void)
+{
+    (void)cycle_counter_init();
+
+    if(!Cy_SysPm_RegisterCallback(&power_policy_callback))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_set
+ *******************************************************************************
+ * Summary:
+ *  Selects the power policy. It applies from the next time the idle task
+ *  tries to enter Deep Sleep.
+ *
+ * Parameters:
+ *  power_policy_t policy: Policy to apply
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void power_policy_set(power_policy_t policy)
+{
+    if(policy < POWER_POLICY_COUNT)
+    {
+        power_policy = policy;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_get
+ *******************************************************************************
+ * Summary:
+ *  Returns the power policy in effect.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  power_policy_t: Policy in effect.
+ *
+ *******************************************************************************/
+power_policy_t power_policy_get(void)
+{
+    return power_policy;
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_wake_source
+ *******************************************************************************
+ * Summary:
+ *  Called at the start of the interrupt of a wake source, the Ethernet MAC or
+ *  the user button. If that interrupt ended a Deep Sleep, the request that
+ *  follows is timed from now. Safe from interrupt context.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void power_policy_wake_source(void)
+{
+    UBaseType_t interrupt_mask;
+
+    interrupt_mask = taskENTER_CRITICAL_FROM_ISR();
+    if(power_policy_woke)
+    {
+        power_policy_woke = false;
+        power_policy_wake_cycles = cycle_counter_read();
+        power_policy_wake_pending = true;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(interrupt_mask);
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_request_start
+ *******************************************************************************
+ * Summary:
+ *  Returns the time from which the response to a request that just arrived
+ *  is measured: the wake-up from Deep Sleep that the request caused, or now
+ *  if the CPU was already awake.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t: Cycle count to pass to power_policy_response_sent().
+ *
+ *******************************************************************************/
+uint32_t power_policy_request_start(void)
+{
+    uint32_t now = cycle_counter_read();
+    uint32_t start = now;
+
+    taskENTER_CRITICAL();
+    if(power_policy_wake_pending &&
+       ((now - power_policy_wake_cycles) <
+        (POWER_POLICY_WAKE_WINDOW_US * (SystemCoreClock / 1000000U))))
+    {
+        start = power_policy_wake_cycles;
+    }
+    power_policy_wake_pending = false;
+    taskEXIT_CRITICAL();
+
+    return start;
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_response_sent
+ *******************************************************************************
+ * Summary:
+ *  Adds the latency of a response to the measurements of the policy in
+ *  effect.
+ *
+ * Parameters:
+ *  uint32_t start: Cycle count returned by power_policy_request_start()
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void power_policy_response_sent(uint32_t start)
+{
+    uint32_t latency = cycle_counter_read() - start;
+    power_policy_counts_t *counts;
+
+    taskENTER_CRITICAL();
+    counts = &power_policy_counts[power_policy];
+    counts->responses++;
+    counts->latency_cycles += latency;
+    if(latency > counts->latency_max_cycles)
+    {
+        counts->latency_max_cycles = latency;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_report
+ *******************************************************************************
+ * Summary:
+ *  Returns the measurements of every policy since start-up.
+ *
+ * Parameters:
+ *  power_policy_stats_t stats[]: Destination of the measurements, indexed
+ *   by policy
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void power_policy_report(power_policy_stats_t stats[POWER_POLICY_COUNT])
+{
+    power_policy_counts_t counts[POWER_POLICY_COUNT];
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    uint32_t index;
+
+    taskENTER_CRITICAL();
+    memcpy(counts, power_policy_counts, sizeof(counts));
+    taskEXIT_CRITICAL();
+
+    for(index = 0U; index < (uint32_t)POWER_POLICY_COUNT; index++)
+    {
+        stats[index].responses = counts[index].responses;
+        stats[index].latency_mean_us = (0U == counts[index].responses) ? 0U :
+            (uint32_t)(counts[index].latency_cycles / counts[index].responses / cycles_per_us);
+        stats[index].latency_max_us = counts[index].latency_max_cycles / cycles_per_us;
+        stats[index].deep_sleeps = counts[index].deep_sleeps;
+        stats[index].deep_sleeps_held_off = counts[index].deep_sleeps_held_off;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_deepsleep_callback
+ *******************************************************************************
+ * Summary:
+ *  Deep Sleep callback. In the low-latency policy it refuses Deep Sleep while
+ *  a client is connected or a transmit batch is not empty, which leaves the
+ *  idle task in CPU Sleep. It also counts the Deep Sleep entries and notes
+ *  every wake-up, which the interrupt of the wake source then timestamps.
+ *
+ * Parameters:
+ *  cy_stc_syspm_callback_params_t *callback_params: Callback parameters
+ *   (unused)
+ *  cy_en_syspm_callback_mode_t mode: Step of the Deep Sleep transition
+ *
+ * Return:
+ *  cy_en_syspm_status_t: CY_SYSPM_FAIL to refuse Deep Sleep, CY_SYSPM_SUCCESS
+ *  otherwise.
+ *
+ *******************************************************************************/
+static cy_en_syspm_status_t power_policy_deepsleep_callback(
+    cy_stc_syspm_callback_params_t *callback_params, cy_en_syspm_callback_mode_t mode)
+{
+    app_state_snapshot_t state;
+
+    CY_UNUSED_PARAMETER(callback_params);
+
+    switch(mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            app_state_snapshot(&state);
+            if((POWER_POLICY_LOW_LATENCY == power_policy) &&
+               ((0U != state.connected_clients) || tcp_sessions_tx_pending()))
+            {
+                power_policy_counts[power_policy].deep_sleeps_held_off++;
+                return CY_SYSPM_FAIL;
+            }
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            /* The cycle counter stopped in Deep Sleep; the wake source
+             * interrupt, which runs once the transition is over, takes the
+             * timestamp. */
+            power_policy_counts[power_policy].deep_sleeps++;
+            power_policy_woke = true;
+            break;
+
+        default:
+            break;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/******************************************************************************
+* File Name:   power_policy.h
+*
+* Description: This file is the public interface of power_policy.c, the runtime
+* * choice between low wake-up latency and low power for the Deep Sleep entries
+* * of the idle task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef POWER_POLICY_H_
+#define POWER_POLICY_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include "cy_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Policy in effect at start-up. POWER_POLICY_ECO keeps the Deep Sleep
+ * behaviour of the Device Configurator settings. */
+#define POWER_POLICY_DEFAULT                      (POWER_POLICY_ECO)
+
+/* Longest time, in microseconds, between a wake-up from Deep Sleep and the
+ * request that follows it for the request to be timed from the wake-up. A
+ * request arriving later found the CPU already awake. */
+#define POWER_POLICY_WAKE_WINDOW_US               (1000U)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Power policies. The values are part of the POWER_POLICY frame. */
+typedef enum
+{
+    /* Hold off Deep Sleep while a client is connected or a response is still
+     * queued, so that requests never wait for the system to wake up. */
+    POWER_POLICY_LOW_LATENCY = 0,
+    /* Enter Deep Sleep whenever the idle task can, clients or not. */
+    POWER_POLICY_ECO,
+    POWER_POLICY_COUNT
+} power_policy_t;
+
+/* Measurements of a policy, accumulated while it is in effect. The latency
+ * runs from the interrupt of the wake source that ended a Deep Sleep (see
+ * power_policy_wake_source()), or from the receive callback if the CPU was
+ * already awake, to the end of the send of the response. */
+typedef struct
+{
+    uint32_t responses;
+    uint32_t latency_mean_us;
+    uint32_t latency_max_us;
+    uint32_t deep_sleeps;
+    uint32_t deep_sleeps_held_off;
+} power_policy_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t power_policy_init(void);
+void power_policy_set(power_policy_t policy);
+power_policy_t power_policy_get(void);
+void power_policy_wake_source(void);
+uint32_t power_policy_request_start(void);
+void power_policy_response_sent(uint32_t start);
+void power_policy_report(power_policy_stats_t stats[POWER_POLICY_COUNT]);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* POWER_POLICY_H_ */
+
+/* [] END OF FILE */
@@ -48,122 +48,137 @@
 #include <FreeRTOS.h>
 #include <task.h>
 #include <semphr.h>
+#include <event_groups.h>
 #include "cyabs_rtos.h"
 
 /* Standard C header file */
 #include <string.h>
 /* To use the portable formatting macros */
 #include <inttypes.h>
-#include <string.h>
 
 /* Secure socket header file. */
 #include "cy_secure_sockets.h"
 #include "cy_tls.h"
 
-/* Network connectivity utility header file */
-#include "cy_nw_helper.h"
-/* IP address related header files (part of the lwIP TCP/IP stack). */
-#include "ip_addr.h"
-
-/* Ethernet connection manager header files */
-#include "cy_ecm.h"
-#include "cy_ecm_error.h"
-/* Ethernet PHY header file */
-#include "cy_eth_phy_driver.h"
-
 /* Network credentials and TCP port settings header file */
 #include "network_credentials.h"
+#if (TLS_CREDENTIALS_DER)
+/* DER credentials, generated at build time by scripts/pem_to_der.py */
+#include "network_credentials_der.h"
+#endif
 
 /* Secure TCP client task header file */
 #include "secure_tcp_server.h"
 
-/*******************************************************************************
-* Macros
-********************************************************************************/
+/* Session table header file */
+#include "tcp_session.h"
+
+/* Listener header file */
+#include "tcp_listener.h"
+
+/* Application protocol header file */
+#include "tcp_protocol.h"
+
+/* Streaming header file */
+#include "tcp_stream.h"
+
+/* Interrupt to task event ring header file */
+#include "isr_event_ring.h"
+
+/* Runtime performance counters header file */
+#include "server_stats.h"
+
+/* Deferred logger header file */
+#include "app_log.h"
+
+/* CM55 offload pipeline header file */
+#include "ipc_offload.h"
+
+/* Crypto benchmark header file */
+#include "crypto_benchmark.h"
+
+/* Start-up timeline header file */
+#include "boot_timeline.h"
 
-/* Maximum number of connection retries to the ethernet network */
-#define MAX_ETH_RETRY_COUNT                            (3U)
+/* Ethernet link monitor header file */
+#include "eth_link.h"
 
-/* Length of the LED ON/OFF command issued from the TCP server. */
-#define TCP_LED_CMD_LEN                                (1U)
+/* Memory pool header file */
+#include "mem_pool.h"
 
-/* LED ON and LED OFF commands. */
-#define LED_ON_CMD                                     '1'
-#define LED_OFF_CMD                                    '0'
+/* Shared application state header file */
+#include "app_state.h"
+
+/* Network memory profile header file */
+#include "net_profile.h"
+
+/* Trace ring header file */
+#include "trace_ring.h"
+
+/* Power policy header file */
+#include "power_policy.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
 
 /* Interrupt priority of the user button. */
 #define USER_BTN_INTR_PRIORITY                         (5)
 
-#define RESET_VAL                                      (0U)
 #define DEBOUNCE_DELAY                                 (250U)
-#define TASKNOTIFYBITS_TO_CLEARONENTRY                 (0U)
-#define TASKNOTIFYBITS_TO_CLEARONEXIT                  (0U)
-#define NULL_CHARACTER                                 '\0'
 #define GPIO_INTERRUPT_PRIORITY                        (7U)
 #define DEBOUNCE_TIME_MS                               (100U)
+
+/* Format the TLS credentials are loaded in, named in the start-up timeline
+ * so that the two can be compared. */
+#if (TLS_CREDENTIALS_DER)
+#define TLS_CREDENTIALS_FORMAT_NAME                    "DER"
+#else
+#define TLS_CREDENTIALS_FORMAT_NAME                    "PEM"
+#endif
+
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
 
-cy_rslt_t create_secure_tcp_server_socket(void);
-cy_rslt_t tcp_connection_handler(cy_socket_t socket_handle, void *arg);
-cy_rslt_t tcp_receive_msg_handler(cy_socket_t socket_handle, void *arg);
-cy_rslt_t tcp_disconnection_handler(cy_socket_t socket_handle, void *arg);
 static void user_button_interrupt_handler(void);
 
-/* Establish Ethernet connection to the network. */
-static cy_rslt_t connect_to_ethernet(void);
+/* Event loop handlers. */
+static void tcp_server_button_events(void);
+static cy_rslt_t tcp_server_tasks_init(void);
+static void tcp_server_rx_task(void *arg);
+static void tcp_server_tx_task(void *arg);
+static void tcp_server_link_changed(void);
+static void tcp_server_link_event(bool up);
 
-/* Ethernet PHY callback functions */
-cy_ecm_phy_callbacks_t phy_callbacks =
-{
-    .phy_init = cy_eth_phy_init,
-    .phy_configure = cy_eth_phy_configure,
-    .phy_enable_ext_reg = cy_eth_phy_enable_ext_reg,
-    .phy_discover = cy_eth_phy_discover,
-    .phy_get_auto_neg_status = cy_eth_phy_get_auto_neg_status,
-    .phy_get_link_partner_cap = cy_eth_phy_get_link_partner_cap,
-    .phy_get_linkspeed = cy_eth_phy_get_linkspeed,
-    .phy_get_linkstatus = cy_eth_phy_get_linkstatus,
-    .phy_reset = cy_eth_phy_reset
-};
+/* Memory report. */
+static void tcp_server_memory_report(void);
 
 /*******************************************************************************
 * Global Variables
 ********************************************************************************/
 
-/* Secure socket variables. */
-cy_socket_sockaddr_t tcp_server_addr, peer_addr;
-cy_socket_t server_handle, client_handle;
-
+#if !(TLS_CREDENTIALS_DER)
 /* TLS credentials of the TCP server. */
 static const char tcp_server_cert[] = keySERVER_CERTIFICATE_PEM;
 static const char server_private_key[] = keySERVER_PRIVATE_KEY_PEM;
 
 /* Root CA certificate for TCP client identity verification. */
 static const char tcp_client_ca_cert[] = keyCLIENT_ROOTCA_PEM;
+#endif
 
 /* Variable to store the TLS identity (certificate and private key). */
 void *tls_identity;
 
-/* Size of the peer socket address. */
-uint32_t peer_addr_len;
-
-/* Flags to tack the LED state and command. */
-bool led_state = CYBSP_LED_STATE_OFF;
+/* Events the RX and TX tasks wait for. */
+static EventGroupHandle_t server_events;
 
-/* Secure TCP server task handle. */
-extern TaskHandle_t server_task_handle;
+/* Server (control) task. The button ISR and the link monitor notify it
+ * directly with their SERVER_EVENT_* bits. */
+static TaskHandle_t server_task_handle;
 
-/* Ethernet connection manager handle */
-static cy_ecm_t ecm_handle = NULL;
-
-/* Flag variable to check if TCP client is connected. */
-bool client_connected;
-
-/* Flag to check button pressed event */
-volatile bool button_debouncing = false;
-volatile uint32_t button_debounce_timestamp = 0;
+/* LED commands queued by the user button ISR for the server task. */
+static isr_event_ring_t button_event_ring;
 
 /* Interrupt config structure */
 cy_stc_sysint_t sysint_cfg =
@@ -190,18 +205,35 @@ void tcp_secure_server_task(void *arg)
 {
     cy_rslt_t result;
 
-    /* Variable to store number of bytes sent over TCP socket. */
-    uint32_t bytes_sent = RESET_VAL;
+    /* Events to handle, and the time to wait for the next event before an
+     * idle session must be closed. */
+    uint32_t events;
+    TickType_t wait = portMAX_DELAY;
 
-    /* Variable to receive LED ON/OFF command from the user button ISR. */
-    uint32_t led_state_cmd = LED_OFF_CMD;
+    /* State of the Ethernet link. */
+    eth_link_status_t link_status;
 
+#if !(TLS_CREDENTIALS_DER)
     /* TCP server certificate length and private key length. */
     const size_t tcp_server_cert_len = strlen( tcp_server_cert );
     const size_t pkey_len = strlen( server_private_key );
+#endif
 
     cy_en_sysint_status_t btn_interrupt_init_status;
 
+    /* Publish the task handle before the button ISR and the link monitor can
+     * notify this task. */
+    server_task_handle = xTaskGetCurrentTaskHandle();
+
+    /* Create the event group first: the socket callbacks and the tasks that
+     * queue frames post to it. */
+    server_events = xEventGroupCreate();
+    if(NULL == server_events)
+    {
+        printf("Failed to create the server event group!\n");
+        handle_app_error();
+    }
+
     /* CYBSP_USER_BTN1 (SW2) and CYBSP_USER_BTN2 (SW4) share the same port and
     * hence they share the same NVIC IRQ line. Since both are configured in the
     * BSP via the Device Configurator, the interrupt flags for both the buttons
@@ -224,13 +256,33 @@ void tcp_secure_server_task(void *arg)
     /* Enable the interrupt in the NVIC */
     NVIC_EnableIRQ(sysint_cfg.intrSrc);
 
-    /* Establish ethernet connection. */
-    result = connect_to_ethernet();
+    boot_timeline_mark("Server task started");
+
+    /* Serve the mbedTLS allocations from the memory pools before the secure
+     * socket library starts using it. */
+    result = mem_pool_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to set up the memory pools!\n");
+        handle_app_error();
+    }
+
+    result = power_policy_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to set up the power policy!\n");
+        handle_app_error();
+    }
+
+    /* Start bringing the Ethernet link up. The server starts listening once
+     * the link monitor reports the link up. */
+    result = eth_link_init(tcp_server_link_event);
     if(result!= CY_RSLT_SUCCESS )
     {
-        printf("\n Failed to connect to Ethernet! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
+        printf("\n Failed to start the Ethernet link! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
         handle_app_error();
     }
+    boot_timeline_mark("Ethernet link started");
 
     /* Initialize secure socket library. */
     result = cy_socket_init();
@@ -243,19 +295,93 @@ void tcp_secure_server_task(void *arg)
     {
         printf("Secure Socket initialized.\n");
     }
+    boot_timeline_mark("Secure sockets initialized");
+
+    /* Create the mutex protecting the session table. It is shared between the
+     * server tasks and the secure socket callbacks. */
+    result = tcp_sessions_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to create the session table mutex!\n");
+        handle_app_error();
+    }
 
-    /* Create TCP server identity using the SSL certificate and private key. */
+    /* Create the handshake workers that accept and negotiate new clients. */
+    result = tcp_handshake_pool_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to create the handshake worker pool!\n");
+        handle_app_error();
+    }
+
+    /* Create the queues and tasks of the application protocols. */
+    result = tcp_protocols_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to create the application protocol tasks!\n");
+        handle_app_error();
+    }
+
+    /* Create the streaming task and its block producer. */
+    result = tcp_stream_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to create the streaming task!\n");
+        handle_app_error();
+    }
+
+    /* Create the tasks reading from and sending to the clients. */
+    result = tcp_server_tasks_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to create the RX and TX tasks!\n");
+        handle_app_error();
+    }
+
+    /* Start the runtime performance counters. */
+    result = server_stats_init();
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to start the runtime performance counters!\n");
+        handle_app_error();
+    }
+
+#if (CRYPTO_BENCHMARK_ENABLE)
+    /* Time the handshake and record crypto of the selected PSA driver. */
+    crypto_benchmark_run();
+#endif
+
+#if (IPC_OFFLOAD_BENCHMARK_ENABLE)
+    /* Compare frame processing on CM33 with offloading it to CM55. */
+    ipc_offload_benchmark();
+#endif
+
+    /* Create TCP server identity using the SSL certificate and private key.
+     * mbedTLS tells DER from PEM by the missing PEM header, so the DER blobs
+     * are parsed without the base64 decoding. */
+#if (TLS_CREDENTIALS_DER)
+    result = cy_tls_create_identity((const char *)tcp_server_cert_der, tcp_server_cert_der_len,
+                                    (const char *)server_private_key_der,
+                                    server_private_key_der_len, &tls_identity);
+#else
     result = cy_tls_create_identity(tcp_server_cert, tcp_server_cert_len, server_private_key, pkey_len, &tls_identity);
+#endif
     if(CY_RSLT_SUCCESS != result)
     {
         printf("Failed cy_tls_create_identity! Error code: %"PRIu32"\n", result);
         handle_app_error();
     }
+    boot_timeline_mark("TLS identity created (" TLS_CREDENTIALS_FORMAT_NAME ")");
 
     /* Initializes the global trusted RootCA certificate. This examples uses a self signed
      * certificate which implies that the RootCA certificate is same as the TCP client
      * certificate. */
+#if (TLS_CREDENTIALS_DER)
+    result = cy_tls_load_global_root_ca_certificates((const char *)tcp_client_ca_cert_der,
+                                                     tcp_client_ca_cert_der_len);
+#else
     result = cy_tls_load_global_root_ca_certificates(tcp_client_ca_cert, strlen(tcp_client_ca_cert));
+#endif
     if(CY_RSLT_SUCCESS != result)
     {
         printf("cy_tls_load_global_root_ca_certificates failed! Error code: %"PRIu32"\n", result);
@@ -265,402 +391,292 @@ void tcp_secure_server_task(void *arg)
     {
         printf("Global trusted RootCA certificate loaded\n");
     }
+    boot_timeline_mark("Root CA loaded (" TLS_CREDENTIALS_FORMAT_NAME ")");
 
-    /* Create secure TCP server socket. */
-    result = create_secure_tcp_server_socket();
-    if(CY_RSLT_SUCCESS != result)
+    /* Wait for the link. Only the link event is cleared, so that button
+     * presses are handled once the server runs. */
+    eth_link_get_status(&link_status);
+    while(!link_status.up)
     {
-        printf("Failed to create socket! Error code: %"PRIu32"\n", result);
-        handle_app_error();
+        (void)xTaskNotifyWait(0U, SERVER_EVENT_LINK, NULL, portMAX_DELAY);
+        eth_link_get_status(&link_status);
     }
+    boot_timeline_mark("Ethernet connected");
 
-    /* Start listening on the secure TCP socket. */
-    result = cy_socket_listen(server_handle, TCP_SERVER_MAX_PENDING_CONNECTIONS);
-    if (CY_RSLT_SUCCESS != result)
+    /* Create secure TCP server socket and start listening on it. */
+    result = tcp_server_listen(&link_status);
+    if(CY_RSLT_SUCCESS != result)
     {
-        cy_socket_delete(server_handle);
-        printf("cy_socket_listen returned error. Error: %"PRIu32"\n", result);
         handle_app_error();
     }
-    else
-    {
-        printf("===============================================================\n");
-        printf("Listening for incoming TCP client connection on Port: %d\n",
-                tcp_server_addr.port);
-    }
 
+    boot_timeline_mark("Listening");
+    boot_timeline_print();
+    tcp_server_memory_report();
+    net_profile_report();
+    printf("===============================================================\n");
+    tcp_server_print_listeners();
+
+    /* Control event loop. The receive and send paths run on the RX and TX
+     * tasks; this task handles the button presses and the link changes, and
+     * closes the sessions that have been idle for too long. The idle deadline
+     * of the oldest session bounds the wait. */
     while(true)
     {
-        /* Wait till user button is pressed to send LED ON/OFF command to TCP client. */
-        xTaskNotifyWait(TASKNOTIFYBITS_TO_CLEARONENTRY,
-                        TASKNOTIFYBITS_TO_CLEARONEXIT, &led_state_cmd, portMAX_DELAY);
+        events = 0U;
+        (void)xTaskNotifyWait(0U, SERVER_EVENT_CONTROL, &events, wait);
 
-        /* Send LED ON/OFF command to TCP client if there is an active
-        *  TCP client connection. */
-        if(client_connected)
+        if(0U != (events & SERVER_EVENT_BUTTON))
         {
-            /* Send the command to TCP client. */
-            result = cy_socket_send(client_handle, &led_state_cmd, TCP_LED_CMD_LEN,
-                        CY_SOCKET_FLAGS_NONE, &bytes_sent);
-            if(CY_RSLT_SUCCESS == result)
-            {
-                if(LED_ON_CMD == led_state_cmd)
-                {
-                    printf("\nLED ON command sent to TCP client\n");
-                }
-                else
-                {
-                    printf("\nLED OFF command sent to TCP client\n");
-                }
-            }
-            else
-            {
-                printf("Failed to send command to client. Error: %"PRIu32"\n", result);
-                if(CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED == result)
-                {
-                    /* Disconnect the socket. */
-                        cy_socket_disconnect(client_handle, RESET_VAL);
-                    /* Delete the socket. */
-                    cy_socket_delete(client_handle);
-                }
-            }
+            tcp_server_button_events();
+        }
+
+        if(0U != (events & SERVER_EVENT_LINK))
+        {
+            tcp_server_link_changed();
         }
+
+        wait = tcp_sessions_evict_idle();
     }
 }
 
 /*******************************************************************************
- * Function Name: connect_ethernet
+ * Function Name: tcp_server_tasks_init
  *******************************************************************************
  * Summary:
- *  Connect to ethernet, retries up to a configured number
- *  of times until the connection succeeds.
+ *  Creates the RX task and the TX task.
  *
- * * Parameters:
- *  None
+ * Parameters:
+ *  void
  *
  * Return:
- *  cy_rslt_t result: Result of the operation.
+ *  cy_result result: Result of the operation.
  *
  *******************************************************************************/
-cy_rslt_t connect_to_ethernet(void)
+static cy_rslt_t tcp_server_tasks_init(void)
 {
-    cy_rslt_t result = CY_RSLT_SUCCESS;
-
-    uint8_t retry_count = 0;
-
-    /* Variables used by Ethernet connection manager.*/
-    cy_ecm_ip_address_t ip_addr;
-
-    /* Initialize Ethernet connection manager. */
-    result = cy_ecm_init();
-    if (result != CY_RSLT_SUCCESS)
-    {
-        printf("Ethernet connection manager initialization failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
-        handle_app_error();
-    }
-    else
+    if(pdPASS != xTaskCreate(tcp_server_rx_task, "RX task", TCP_SERVER_RX_TASK_STACK_SIZE,
+                             NULL, TCP_SERVER_RX_TASK_PRIORITY, NULL))
     {
-        printf("Ethernet connection manager initialized.\n");
+        return CY_RSLT_TYPE_ERROR;
     }
 
-    /* Initialize the Ethernet interface and PHY driver */
-    result =  cy_ecm_ethif_init(CY_ECM_INTERFACE_ETH0, &phy_callbacks, &ecm_handle);
-    if (result != CY_RSLT_SUCCESS)
+    if(pdPASS != xTaskCreate(tcp_server_tx_task, "TX task", TCP_SERVER_TX_TASK_STACK_SIZE,
+                             NULL, TCP_SERVER_TX_TASK_PRIORITY, NULL))
     {
-        printf("Ethernet interface initialization failed! Error code: 0x%08"PRIx32"\n", (uint32_t)result);
-        handle_app_error();
+        return CY_RSLT_TYPE_ERROR;
     }
 
-    /* Establish a connection to the ethernet network */
-    while(true)
-    {
-        result = cy_ecm_connect(ecm_handle, NULL, &ip_addr);
-        if(result != CY_RSLT_SUCCESS)
-        {
-            retry_count++;
-            if (retry_count >= MAX_ETH_RETRY_COUNT)
-            {
-                printf("Exceeded max ethernet connection attempts\n");
-                return result;
-            }
-            printf("Connection to ethernet network failed. Retrying...\n");
-            continue;
-        }
-        else
-        {
-            printf("Successfully connected to ethernet.\n");
-
-        #if(USE_IPV6_ADDRESS)
-            result = cy_ecm_get_ipv6_address(ecm_handle, CY_ECM_IPV6_LINK_LOCAL, &ip_addr);
-            if(result == CY_RSLT_SUCCESS)
-            {
-                printf("IPv6 address (link-local) assigned: %s\n",
-                        ip6addr_ntoa((const ip6_addr_t*)&ip_addr.ip.v6));
-                memcpy(ip_addr.ip.v6, tcp_server_addr.ip_address.ip.v6, sizeof(ip_addr.ip.v6));
-                tcp_server_addr.ip_address.version = CY_SOCKET_IP_VER_V6;
-                tcp_server_addr.port = TCP_SERVER_PORT;
-            }
-        #else
-            printf("IPv4 address assigned: %s\n", ip4addr_ntoa((const ip4_addr_t*)&ip_addr.ip.v4));
-
-            /* IP address and TCP port number of the TCP server */
-            tcp_server_addr.ip_address.ip.v4 = ip_addr.ip.v4;
-            tcp_server_addr.ip_address.version = CY_SOCKET_IP_VER_V4;
-            tcp_server_addr.port = TCP_SERVER_PORT;
-        #endif
-
-            break;
-        }
-    }
-    return result;
+    return CY_RSLT_SUCCESS;
 }
 
 /*******************************************************************************
- * Function Name: create_secure_tcp_server_socket
+ * Function Name: tcp_server_rx_task
  *******************************************************************************
  * Summary:
- *  Function to create a socket and set the socket options for configuring TLS
- *  identity, socket connection handler, message reception handler and
- *  socket disconnection handler.
+ *  RX task. Reads from every client socket the receive callback marked
+ *  readable and dispatches the frames received to their protocol.
  *
-* Parameters:
-*  void.
-*
-* Return:
-*  cy_result result: Result of the operation.
-*
-*******************************************************************************/
-cy_rslt_t create_secure_tcp_server_socket(void)
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_server_rx_task(void *arg)
 {
-    cy_rslt_t result;
-    /* TCP socket receive timeout period. */
-    uint32_t tcp_recv_timeout = TCP_SERVER_RECV_TIMEOUT_MS;
-
-    /* Variables used to set socket options. */
-    cy_socket_opt_callback_t tcp_receive_option;
-    cy_socket_opt_callback_t tcp_connection_option;
-    cy_socket_opt_callback_t tcp_disconnect_option;
+    CY_UNUSED_PARAMETER(arg);
 
-    /* TLS authentication mode.*/
-    cy_socket_tls_auth_mode_t tls_auth_mode = CY_SOCKET_TLS_VERIFY_REQUIRED;
-
-    /* Create a Secure TCP socket. */
-#if(USE_IPV6_ADDRESS)
-    result = cy_socket_create(CY_SOCKET_DOMAIN_AF_INET6, CY_SOCKET_TYPE_STREAM,
-                                  CY_SOCKET_IPPROTO_TLS, &server_handle);
-#else
-    result = cy_socket_create(CY_SOCKET_DOMAIN_AF_INET, CY_SOCKET_TYPE_STREAM,
-                                  CY_SOCKET_IPPROTO_TLS, &server_handle);
-#endif
-    if(CY_RSLT_SUCCESS != result)
+    while(true)
     {
-        printf("Failed to create socket! Error code: %"PRIu32"\n", result);
-        return result;
+        (void)xEventGroupWaitBits(server_events, SERVER_EVENT_RX, pdTRUE, pdFALSE,
+                                  portMAX_DELAY);
+        tcp_sessions_receive_ready();
     }
+}
 
-    /* Set the TCP socket receive timeout period. */
-    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_SOCKET,
-                                 CY_SOCKET_SO_RCVTIMEO, &tcp_recv_timeout,
-                                 sizeof(tcp_recv_timeout));
-    if(CY_RSLT_SUCCESS != result)
-    {
-        printf("Set socket option: CY_SOCKET_SO_RCVTIMEO failed! Error code: %"PRIu32"\n", result);
-        return result;
-    }
+/*******************************************************************************
+ * Function Name: tcp_server_tx_task
+ *******************************************************************************
+ * Summary:
+ *  TX task. Sends the transmit batches that reached their flush deadline,
+ *  waiting for the deadline of the oldest pending batch or for a frame
+ *  queued to an empty batch.
+ *
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_server_tx_task(void *arg)
+{
+    TickType_t wait = portMAX_DELAY;
 
-    /* Register the callback function to handle connection request from a TCP client. */
-    tcp_connection_option.callback = tcp_connection_handler;
-    tcp_connection_option.arg = NULL;
+    CY_UNUSED_PARAMETER(arg);
 
-    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_SOCKET,
-                                  CY_SOCKET_SO_CONNECT_REQUEST_CALLBACK,
-                                  &tcp_connection_option, sizeof(cy_socket_opt_callback_t));
-    if(result != CY_RSLT_SUCCESS)
+    while(true)
     {
-        printf("Set socket option: CY_SOCKET_SO_CONNECT_REQUEST_CALLBACK failed! Error code: %"PRIu32"\n", result);
-        return result;
+        (void)xEventGroupWaitBits(server_events, SERVER_EVENT_TX, pdTRUE, pdFALSE, wait);
+        wait = tcp_sessions_flush_due();
     }
+}
 
-    /* Register the callback function to handle messages received from a TCP client. */
-    tcp_receive_option.callback = tcp_receive_msg_handler;
-    tcp_receive_option.arg = NULL;
+/*******************************************************************************
+ * Function Name: tcp_server_button_events
+ *******************************************************************************
+ * Summary:
+ *  Queues the LED ON/OFF command of every button event queued by the ISR to
+ *  every connected client. A single wake-up can cover many button events.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_server_button_events(void)
+{
+    static uint32_t dropped_events;
+    isr_event_t button_event;
+    uint32_t queued;
+    uint32_t index;
+    uint8_t led_cmd;
 
-    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_SOCKET,
-                                  CY_SOCKET_SO_RECEIVE_CALLBACK,
-                                  &tcp_receive_option, sizeof(cy_socket_opt_callback_t));
-    if(CY_RSLT_SUCCESS != result)
+    while(isr_event_ring_pop(&button_event_ring, &button_event))
     {
-        printf("Set socket option: CY_SOCKET_SO_RECEIVE_CALLBACK failed! Error code: %"PRIu32"\n", result);
-        return result;
-    }
+        /* Queue LED ON/OFF command to every TCP client with an active
+        *  TCP client connection. */
+        led_cmd = (uint8_t)button_event.value;
+        queued = 0U;
 
-    /* Register the callback function to handle disconnection. */
-    tcp_disconnect_option.callback = tcp_disconnection_handler;
-    tcp_disconnect_option.arg = NULL;
+        for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+        {
+            /* Only the control protocol carries LED commands. */
+            if(TCP_PROTOCOL_CONTROL != tcp_sessions[index].protocol)
+            {
+                continue;
+            }
 
-    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_SOCKET,
-                                  CY_SOCKET_SO_DISCONNECT_CALLBACK,
-                                  &tcp_disconnect_option, sizeof(cy_socket_opt_callback_t));
-    if(CY_RSLT_SUCCESS != result)
-    {
-        printf("Set socket option: CY_SOCKET_SO_DISCONNECT_CALLBACK failed! Error code: %"PRIu32"\n", result);
-        return result;
-    }
+            if(tcp_session_queue_frame(&tcp_sessions[index], NULL, TCP_FRAME_TYPE_LED_CMD,
+                                       &led_cmd, TCP_LED_CMD_LEN))
+            {
+                trace_point(TRACE_EVENT_LED_QUEUED, index, led_cmd);
+                queued++;
+            }
+        }
 
-    /* Set the TCP socket to use the TLS identity. */
-    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_TLS, CY_SOCKET_SO_TLS_IDENTITY,
-                                  tls_identity, strlen(tls_identity));
-    if(CY_RSLT_SUCCESS != result)
-    {
-        printf("Failed cy_socket_setsockopt! Error code: %"PRIu32"\n", result);
-        return result;
+        APP_LOG_INFO("\nLED %s command queued to %"PRIu32" TCP client(s), "
+                     "%"PRIu32" ms after the button press\n",
+                     (LED_ON_CMD == led_cmd) ? "ON" : "OFF", queued,
+                     (uint32_t)((xTaskGetTickCount() - button_event.timestamp) *
+                                portTICK_PERIOD_MS));
     }
 
-    /* Set the TLS authentication mode. */
-    cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_TLS, CY_SOCKET_SO_TLS_AUTH_MODE,
-                        &tls_auth_mode, sizeof(cy_socket_tls_auth_mode_t));
-
-     /* Bind the TCP socket created to Server IP address and to TCP port. */
-    result = cy_socket_bind(server_handle, &tcp_server_addr, sizeof(tcp_server_addr));
-    if(result != CY_RSLT_SUCCESS)
+    if(dropped_events != isr_event_ring_dropped(&button_event_ring))
     {
-        printf("Failed to bind to socket! Error code: %"PRIu32"\n", result);
+        dropped_events = isr_event_ring_dropped(&button_event_ring);
+        APP_LOG_WARN("Button event ring full, %"PRIu32" event(s) dropped so far\n",
+                     dropped_events);
     }
-
-    return result;
 }
 
 /*******************************************************************************
- * Function Name: tcp_connection_handler
+ * Function Name: tcp_server_link_changed
  *******************************************************************************
  * Summary:
- *  Callback function to handle incoming secure TCP client connection.
+ *  Handles a link change. The listening socket survives a link loss as long
+ *  as the address does not change; otherwise it is bound again.
  *
  * Parameters:
- * cy_socket_t socket_handle: Connection handle for the TCP server socket
- *  void *args : Parameter passed on to the function (unused)
+ *  void
  *
  * Return:
- *  cy_result result: Result of the operation
+ *  void
  *
  *******************************************************************************/
-cy_rslt_t tcp_connection_handler(cy_socket_t socket_handle, void *arg)
+static void tcp_server_link_changed(void)
 {
-    cy_rslt_t result;
-    /* Accept new incoming connection from a TCP client and
-     * perform TLS handshake. */
-    result = cy_socket_accept(socket_handle, &peer_addr, &peer_addr_len,
-                              &client_handle);
-    if(CY_RSLT_SUCCESS == result )
-    {
-        printf("Incoming TCP connection accepted\n");
-        printf("TLS Handshake successful and communication secured!\n");
-        printf("Press the user button to send LED ON/OFF command to the TCP client\n");
+    eth_link_status_t link_status;
 
-        /* Set the client connection flag as true. */
-        client_connected = true;
-    }
-    else
+    eth_link_get_status(&link_status);
+    if(link_status.up && (CY_RSLT_SUCCESS != tcp_server_listen(&link_status)))
     {
-        printf("Failed to accept incoming client connection. Error: %"PRIu32"\n", result);
-        printf("===============================================================\n");
-        printf("Listening for incoming TCP client connection on Port: %d\n",
-                tcp_server_addr.port);
+        APP_LOG_ERROR("Not listening until the next link change\n");
     }
-
-    return result;
 }
 
- /*******************************************************************************
- * Function Name: tcp_receive_msg_handler
+/*******************************************************************************
+ * Function Name: tcp_server_link_event
  *******************************************************************************
  * Summary:
- *  Callback function to handle incoming TCP client messages.
+ *  Ethernet link monitor callback. Wakes up the server task, which handles the
+ *  new link state.
  *
  * Parameters:
- * cy_socket_t socket_handle: Connection handle for the TCP client socket
- *  void *args : Parameter passed on to the function (unused)
+ *  bool up: true if the link is up
  *
  * Return:
- *  cy_result result: Result of the operation
+ *  void
  *
  *******************************************************************************/
-cy_rslt_t tcp_receive_msg_handler(cy_socket_t socket_handle, void *arg)
+static void tcp_server_link_event(bool up)
 {
-    char message_buffer[MAX_TCP_RECV_BUFFER_SIZE];
-    cy_rslt_t result;
-
-    /* Variable to store number of bytes received from TCP client. */
-    uint32_t bytes_received = RESET_VAL;
-    result = cy_socket_recv(socket_handle, message_buffer, MAX_TCP_RECV_BUFFER_SIZE,
-                            CY_SOCKET_FLAGS_NONE, &bytes_received);
-
-    if(CY_RSLT_SUCCESS == result )
-    {
-        /* Terminate the received string with '\0'. */
-        message_buffer[bytes_received] = NULL_CHARACTER;
-        printf("\r\nAcknowledgement from TCP Client: %s\n", message_buffer);
-
-        /* Set the LED state based on the acknowledgement received from the TCP client. */
-        if(strcmp(message_buffer, "LED ON ACK") == RESET_VAL)
-        {
-            led_state = CYBSP_LED_STATE_ON;
-        }
-        else
-        {
-            led_state = CYBSP_LED_STATE_OFF;
-        }
-    }
-    else
-    {
-        printf("Failed to receive acknowledgement from the secure TCP client. Error: %"PRIu32"\n",
-        result);
-        if(CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED == result )
-        {
-            /* Disconnect the socket. */
-            cy_socket_disconnect(socket_handle, RESET_VAL);
-            /* Delete the socket. */
-            cy_socket_delete(socket_handle);
-        }
-    }
-
-    printf("===============================================================\n");
-    printf("Press the user button to send LED ON/OFF command to the TCP client\n");
+    CY_UNUSED_PARAMETER(up);
 
-    return result;
+    (void)xTaskNotify(server_task_handle, SERVER_EVENT_LINK, eSetBits);
 }
 
- /*******************************************************************************
- * Function Name: tcp_disconnection_handler
+/*******************************************************************************
+ * Function Name: tcp_server_memory_report
  *******************************************************************************
  * Summary:
- *  Callback function to handle TCP client disconnection event.
+ *  Prints the memory a client session takes with the configured TLS record
+ *  lengths, next to what it takes with the 16 KB records of TLS.
  *
  * Parameters:
- * cy_socket_t socket_handle: Connection handle for the TCP client socket
- *  void *args : Parameter passed on to the function (unused)
+ *  void
  *
  * Return:
- *  cy_result result: Result of the operation
+ *  void
  *
  *******************************************************************************/
-cy_rslt_t tcp_disconnection_handler(cy_socket_t socket_handle, void *arg)
+static void tcp_server_memory_report(void)
 {
-    cy_rslt_t result;
-
-    /* Disconnect the TCP client. */
-    result = cy_socket_disconnect(socket_handle, RESET_VAL);
-    /* Delete the socket. */
-    cy_socket_delete(socket_handle);
-
-    /* Set the client connection flag as false. */
-    client_connected = false;
-    printf("TCP Client disconnected! Please reconnect the TCP Client\n");
-    printf("===============================================================\n");
-    printf("Listening for incoming TCP client connection on Port:%d\n",
-            tcp_server_addr.port);
+    const uint32_t records = MEM_POOL_RECORD_IN_BLOCK_SIZE + MEM_POOL_RECORD_OUT_BLOCK_SIZE;
+    const uint32_t max_records = 2U * MEM_POOL_ALIGN(MEM_POOL_TLS_MAX_CONTENT_LEN +
+                                                     MEM_POOL_RECORD_OVERHEAD);
+    const uint32_t session = (uint32_t)sizeof(tcp_session_t);
+
+    printf("TLS record content: %"PRIu32" bytes in, %"PRIu32" bytes out\n",
+           (uint32_t)MBEDTLS_SSL_IN_CONTENT_LEN, (uint32_t)MBEDTLS_SSL_OUT_CONTENT_LEN);
+    printf("Memory per session: %"PRIu32" bytes (%"PRIu32" of TLS record buffers, "
+           "%"PRIu32" of session state)\n", records + session, records, session);
+    printf("Memory per session with 16 KB records: %"PRIu32" bytes, %"PRIu32" more "
+           "for %"PRIu32" clients\n", max_records + session,
+           (max_records - records) * TCP_SERVER_MAX_CLIENTS, TCP_SERVER_MAX_CLIENTS);
+}
 
-    return result;
+/*******************************************************************************
+ * Function Name: tcp_server_signal
+ *******************************************************************************
+ * Summary:
+ *  Posts events to the RX and TX tasks. Used by the session, protocol and
+ *  stream modules from task context.
+ *
+ * Parameters:
+ *  uint32_t events: SERVER_EVENT_* bits to set
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_server_signal(uint32_t events)
+{
+    xEventGroupSetBits(server_events, (EventBits_t)events);
 }
 
 /*******************************************************************************
@@ -684,31 +700,25 @@ void user_button_interrupt_handler(void)
 
     /* Variable to hold the LED ON/OFF command to be sent to the TCP client. */
     uint32_t led_state_cmd;
+    bool led_on;
+
+    /* Time of this interrupt, read once for debounce and the event timestamp. */
+    TickType_t now = xTaskGetTickCountFromISR();
+
+    trace_point(TRACE_EVENT_BUTTON_ISR, TRACE_NO_SESSION, 0U);
+    power_policy_wake_source();
 
     if (Cy_GPIO_GetInterruptStatus(CYBSP_USER_BTN1_PORT, CYBSP_USER_BTN1_PIN))
     {
         Cy_GPIO_ClearInterrupt(CYBSP_USER_BTN1_PORT, CYBSP_USER_BTN1_PIN);
         NVIC_ClearPendingIRQ(CYBSP_USER_BTN1_IRQ);
 
-        if (!button_debouncing)
-        {
-            if ((xTaskGetTickCount() *
-                portTICK_PERIOD_MS) - button_debounce_timestamp >=
-                DEBOUNCE_TIME_MS * portTICK_PERIOD_MS)
-            {
-                /* Set the debouncing flag */
-                button_debouncing = true;
-
-                /* Record the current timestamp */
-                button_debounce_timestamp = (uint32_t) (xTaskGetTickCount()
-                * portTICK_PERIOD_MS);
-            }
-        }
-
-        if (button_debouncing)
+        /* Record the press if it is not a bounce of the previous one. */
+        if (app_state_button_press((uint32_t)(now * portTICK_PERIOD_MS), DEBOUNCE_TIME_MS,
+                                   &led_on))
         {
             /* Set the command to be sent to TCP client. */
-            if(CYBSP_LED_STATE_ON == led_state)
+            if(led_on)
             {
                 led_state_cmd = LED_OFF_CMD;
             }
@@ -717,12 +727,14 @@ void user_button_interrupt_handler(void)
                 led_state_cmd = LED_ON_CMD;
             }
 
-            button_debouncing = false;
-
-            /* Set the flag to send command to TCP client. */
-            xTaskNotifyFromISR(server_task_handle, led_state_cmd,
-            eSetValueWithoutOverwrite, &xHigherPriorityTaskWoken);
-            portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+            /* Queue the command and wake the server task. Events that find
+             * the ring full are counted as dropped. The notification sets the
+             * bit in the task itself, so unlike an event group it is never
+             * deferred to the timer task and cannot fail. */
+            (void)isr_event_ring_push(&button_event_ring, led_state_cmd,
+                                      (uint32_t)now);
+            (void)xTaskNotifyFromISR(server_task_handle, SERVER_EVENT_BUTTON, eSetBits,
+                                     &xHigherPriorityTaskWoken);
         }
     }
 
@@ -47,14 +47,22 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/*******************************************************************************
+* Header Files
+********************************************************************************/
+#include <stdint.h>
+
 /*******************************************************************************
 * Macros
 ********************************************************************************/
 
-/* Set this macro to '1' to enable IPv6 protocol. Default value is '0' to use
- * IPv4 protocol.
+/* Address families the server listens on. Each enabled family gets its own
+ * listening socket, bound once the interface has an address in that family
+ * (IPv6 uses the link-local address). Both sockets share the TLS identity and
+ * the session table, so one image serves IPv4 and IPv6 clients at once.
  */
-#define USE_IPV6_ADDRESS                          (0U)
+#define TCP_SERVER_IPV4_ENABLE                    (1U)
+#define TCP_SERVER_IPV6_ENABLE                    (1U)
 
 /* TCP server related macros. */
 #define TCP_SERVER_PORT                           (50007U)
@@ -62,12 +70,221 @@ extern "C" {
 /* TCP server related macros */
 #define TCP_SERVER_MAX_PENDING_CONNECTIONS        (3U)
 #define TCP_SERVER_RECV_TIMEOUT_MS                (2000U)
-#define MAX_TCP_RECV_BUFFER_SIZE                  (30U)
+
+/* Maximum number of secure TCP clients served concurrently. Each client
+ * occupies one slot of the statically allocated session table.
+ */
+#define TCP_SERVER_MAX_CLIENTS                    (4U)
+
+/* Size of the per-session receive buffer reassembling application frames
+ * from TLS records. It bounds the largest frame a client may send.
+ */
+#define TCP_SESSION_RX_BUFFER_SIZE                (512U)
+
+/* Receive timeout of an accepted client socket. The RX task keeps
+ * reading while the buffer fills up completely, and this bounds the wait of
+ * the last read once the TLS record layer has been drained.
+ */
+#define TCP_SESSION_DRAIN_TIMEOUT_MS              (1U)
+
+/* Idle session handling. A session that received nothing from its client for
+ * TCP_SESSION_IDLE_TIMEOUT_MS is closed (0 keeps idle sessions open). When
+ * the table is full, a new connection evicts the least recently active
+ * session, provided it has been idle for at least
+ * TCP_SESSION_EVICT_MIN_IDLE_MS, so that a connection storm cannot push out
+ * clients that are in use.
+ */
+#define TCP_SESSION_IDLE_TIMEOUT_MS               (300000U)
+#define TCP_SESSION_EVICT_MIN_IDLE_MS             (10000U)
+
+/* TCP keepalive of the client sockets, so that a peer that vanished without
+ * closing the connection is detected by the stack even when the server has
+ * nothing to send. Probes start after TCP_SESSION_KEEPALIVE_IDLE_MS without
+ * traffic and the connection is dropped after TCP_SESSION_KEEPALIVE_COUNT
+ * unanswered probes sent TCP_SESSION_KEEPALIVE_INTERVAL_MS apart.
+ */
+#define TCP_SESSION_KEEPALIVE_ENABLE              (1U)
+#define TCP_SESSION_KEEPALIVE_IDLE_MS             (30000U)
+#define TCP_SESSION_KEEPALIVE_INTERVAL_MS         (5000U)
+#define TCP_SESSION_KEEPALIVE_COUNT               (3U)
+
+/* Transmit batching. Frames queued to a session are coalesced and sent as a
+ * single TLS record once TCP_SESSION_TX_BATCH_SIZE bytes are pending, or
+ * TCP_SESSION_TX_FLUSH_LATENCY_MS after the first frame of the batch was
+ * queued, whichever comes first.
+ */
+#define TCP_SESSION_TX_BATCH_SIZE                 (512U)
+#define TCP_SESSION_TX_FLUSH_LATENCY_MS           (5U)
+
+/* Handshake worker pool. Connections wait in the listen backlog, up to
+ * TCP_SERVER_MAX_PENDING_CONNECTIONS of them, until a worker accepts them and
+ * runs the TLS handshake instead of the secure socket callback thread.
+ */
+#define TCP_SERVER_HANDSHAKE_WORKERS              (2U)
+#define TCP_SERVER_HANDSHAKE_TASK_STACK_SIZE      (1024U * 5U)
+#define TCP_SERVER_HANDSHAKE_TASK_PRIORITY        (1U)
+
+/* Server tasks. The RX task reads from the readable client sockets and
+ * dispatches their frames, and the TX task flushes the transmit batches as
+ * their deadline comes. The server task started from main.c handles the
+ * control events, the button presses and the link changes, at a higher
+ * priority than both, so that an LED command is queued even while bulk
+ * traffic keeps the RX and TX tasks busy. The stack sizes can be trimmed from
+ * the stack high-water marks reported in the stats snapshot.
+ */
+#define TCP_SERVER_RX_TASK_STACK_SIZE             (1024U * 4U)
+#define TCP_SERVER_RX_TASK_PRIORITY               (2U)
+#define TCP_SERVER_TX_TASK_STACK_SIZE             (1024U * 4U)
+#define TCP_SERVER_TX_TASK_PRIORITY               (2U)
+
+/* Application framing protocol. Every message exchanged with a client is a
+ * frame made of a 1-byte type, a 2-byte big-endian payload length and the
+ * payload. A TLS record may carry several frames and a frame may span
+ * several records.
+ */
+#define TCP_FRAME_HEADER_LEN                      (3U)
+#define TCP_FRAME_MAX_PAYLOAD_LEN                 (TCP_SESSION_RX_BUFFER_SIZE - TCP_FRAME_HEADER_LEN)
+
+/* Length of the LED ON/OFF command issued from the TCP server. */
+#define TCP_LED_CMD_LEN                           (1U)
+
+/* LED ON and LED OFF commands. */
+#define LED_ON_CMD                                '1'
+#define LED_OFF_CMD                               '0'
+
+/* Frame types. */
+#define TCP_FRAME_TYPE_LED_CMD                    (0x01U)
+#define TCP_FRAME_TYPE_LED_ACK                    (0x02U)
+#define TCP_FRAME_TYPE_STATS_REQ                  (0x03U)
+#define TCP_FRAME_TYPE_STATS_RSP                  (0x04U)
+#define TCP_FRAME_TYPE_DATA                       (0x05U)
+#define TCP_FRAME_TYPE_DATA_ACK                   (0x06U)
+#define TCP_FRAME_TYPE_PROTOCOL_SELECT            (0x07U)
+#define TCP_FRAME_TYPE_PROTOCOL_ACK               (0x08U)
+#define TCP_FRAME_TYPE_STREAM_START               (0x09U)
+#define TCP_FRAME_TYPE_STREAM_CREDIT              (0x0AU)
+#define TCP_FRAME_TYPE_STREAM_STOP                (0x0BU)
+#define TCP_FRAME_TYPE_STREAM_DATA                (0x0CU)
+#define TCP_FRAME_TYPE_STREAM_REPORT              (0x0DU)
+#define TCP_FRAME_TYPE_TRACE_REQ                  (0x0EU)
+#define TCP_FRAME_TYPE_TRACE_RSP                  (0x0FU)
+#define TCP_FRAME_TYPE_POWER_POLICY               (0x10U)
+#define TCP_FRAME_TYPE_POWER_REPORT               (0x11U)
+#define TCP_FRAME_TYPE_COUNT                      (0x12U)
+
+/* Length of a DATA_ACK payload: the big-endian CRC-32 of the DATA payload. */
+#define TCP_FRAME_DATA_ACK_LEN                    (4U)
+
+/* Length of a PROTOCOL_ACK payload: the index of the selected protocol, or
+ * TCP_PROTOCOL_UNKNOWN if the name in the PROTOCOL_SELECT frame is unknown. */
+#define TCP_FRAME_PROTOCOL_ACK_LEN                (1U)
+#define TCP_PROTOCOL_UNKNOWN                      (0xFFU)
+
+/* Payload lengths of the streaming frames. STREAM_START carries the number
+ * of blocks to send (0 until STREAM_STOP), STREAM_CREDIT the number of blocks
+ * the client grants, STREAM_DATA a 4-byte sequence number followed by the
+ * block, and STREAM_REPORT the blocks and bytes sent, the duration in ms, the
+ * throughput in bytes per second and the CPU load of the sends in permille,
+ * all big-endian. */
+#define TCP_FRAME_STREAM_START_LEN                (4U)
+#define TCP_FRAME_STREAM_CREDIT_LEN               (2U)
+#define TCP_FRAME_STREAM_SEQUENCE_LEN             (4U)
+#define TCP_FRAME_STREAM_REPORT_LEN               (18U)
+
+/* TRACE_RSP frames. A TRACE_REQ frame is answered with the records of the
+ * trace ring (see trace_ring.h), oldest first, in as many TRACE_RSP frames as
+ * needed. Each starts with the core clock in Hz (u32), the number of records
+ * of the dump (u16), the index of its first record (u16), its number of
+ * records (u8) and flags (u8), followed by the records: cycle count (u32),
+ * trace point (u8), session index (u8) and value (u16), all big-endian. The
+ * dump ends with the frame whose records reach the end; an empty ring is
+ * answered with a single frame of no records. A dump cut short because the
+ * transmit batch had no room ends instead with a frame of no records that has
+ * the TRUNCATED flag set; the ring is then kept until a dump completes, so the
+ * request can be sent again. */
+#define TCP_FRAME_TRACE_RSP_HEADER_LEN            (10U)
+#define TCP_FRAME_TRACE_RSP_TRUNCATED             (0x01U)
+#define TCP_FRAME_TRACE_RECORD_LEN                (8U)
+#define TCP_FRAME_TRACE_RECORDS_MAX               ((TCP_SESSION_TX_BATCH_SIZE - TCP_FRAME_HEADER_LEN - \
+                                                    TCP_FRAME_TRACE_RSP_HEADER_LEN) / \
+                                                   TCP_FRAME_TRACE_RECORD_LEN)
+
+/* POWER_POLICY frames select the power policy (see power_policy.h) with a
+ * 1-byte payload, or only ask for the report with an empty one. They are
+ * answered with a POWER_REPORT frame: the policy in effect (u8), then for
+ * each of the two policies the responses measured, the mean and the longest
+ * wake-up to response latency in microseconds, the Deep Sleep entries and
+ * the Deep Sleep entries held off (u32 each, big-endian). */
+#define TCP_FRAME_POWER_POLICY_LEN                (1U)
+#define TCP_FRAME_POWER_REPORT_LEN                (1U + (2U * 20U))
+
+/* Application protocols served on TCP_SERVER_PORT. Each protocol has its own
+ * frame handler table, and its frames are handled by its own task, which
+ * takes them from a queue of TCP_PROTOCOL_*_QUEUE_DEPTH frames. A queue depth
+ * of 0 handles the frames on the RX task instead. When the queue of a
+ * protocol is full, the RX task stops reading from the session until the
+ * protocol task catches up.
+ *
+ * The control protocol carries the LED commands and the statistics and is
+ * used by sessions that select no protocol. The telemetry protocol carries
+ * the DATA frames of high-rate clients at a lower priority.
+ */
+#define TCP_PROTOCOL_CONTROL_NAME                 "ctrl/1"
+#define TCP_PROTOCOL_CONTROL_QUEUE_DEPTH          (4U)
+#define TCP_PROTOCOL_CONTROL_PRIORITY             (2U)
+#define TCP_PROTOCOL_CONTROL_MAX_PAYLOAD_LEN      (TCP_FRAME_MAX_PAYLOAD_LEN)
+
+#define TCP_PROTOCOL_TELEMETRY_NAME               "telemetry/1"
+#define TCP_PROTOCOL_TELEMETRY_QUEUE_DEPTH        (8U)
+#define TCP_PROTOCOL_TELEMETRY_PRIORITY           (1U)
+#define TCP_PROTOCOL_TELEMETRY_MAX_PAYLOAD_LEN    (TCP_FRAME_MAX_PAYLOAD_LEN)
+
+#define TCP_PROTOCOL_TASK_STACK_SIZE              (1024U * 4U)
+
+/* Streaming. A client on the telemetry protocol starts a stream of sensor
+ * blocks with STREAM_START and grants the server one credit per block it may
+ * send with STREAM_CREDIT, typically one for every block it has consumed.
+ * The stream task only sends against credits, and never holds more than
+ * TCP_STREAM_MAX_CREDITS of them. Keep TCP_STREAM_MAX_CREDITS blocks below
+ * the lwIP send buffer (TCP_SND_BUF) so that a send never waits for the TCP
+ * window.
+ */
+#define TCP_STREAM_MAX_CREDITS                    (4U)
+#define TCP_STREAM_TASK_STACK_SIZE                (1024U * 4U)
+#define TCP_STREAM_TASK_PRIORITY                  (1U)
+
+/* Set this macro to '1' to offer the protocol names through ALPN during the
+ * TLS handshake. The secure sockets library does not report the protocol
+ * negotiated on an accepted socket, so the client still confirms its choice
+ * with a PROTOCOL_SELECT frame.
+ */
+#define TCP_SERVER_ALPN_ENABLE                    (1U)
+#define TCP_SERVER_ALPN_PROTOCOLS                 TCP_PROTOCOL_CONTROL_NAME "," \
+                                                  TCP_PROTOCOL_TELEMETRY_NAME
+
+/* Events of the server tasks. Each task waits for its own events only. The
+ * events of the server (control) task are task notification bits; those of
+ * the RX and TX tasks are bits of an event group. */
+/* Notified by the user button ISR after it queued an event. */
+#define SERVER_EVENT_BUTTON                       (1UL << 0U)
+/* Set when a frame is queued to an empty batch, so that the TX task
+ * schedules the flush of the batch. */
+#define SERVER_EVENT_TX_PENDING                   (1UL << 1U)
+/* Notified by the Ethernet link monitor when the link came up or went down. */
+#define SERVER_EVENT_LINK                         (1UL << 2U)
+/* Set by the receive callback when a client socket has data to read. */
+#define SERVER_EVENT_SOCKET_READABLE              (1UL << 3U)
+/* Events of the server (control) task, of the RX task and of the TX task. */
+#define SERVER_EVENT_CONTROL                      (SERVER_EVENT_BUTTON | \
+                                                  SERVER_EVENT_LINK)
+#define SERVER_EVENT_RX                           (SERVER_EVENT_SOCKET_READABLE)
+#define SERVER_EVENT_TX                           (SERVER_EVENT_TX_PENDING)
 
 /*******************************************************************************
 * Function Prototype
 ********************************************************************************/
 void tcp_secure_server_task(void *arg);
+void tcp_server_signal(uint32_t events);
 
 #if defined(__cplusplus)
 }
@@ -0,0 +1,458 @@
+/******************************************************************************
+* File Name:   server_stats.c
+*
+* Description: This file contains the runtime performance counters of the
+* secure TCP server: event counters, a handshake duration histogram, receive
+* and send rates, buffer high-water marks and the CPU load of every task.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#include <timers.h>
+
+/* Standard C header files */
+#include <string.h>
+
+/* DWT cycle counter header file */
+#include "cycle_counter.h"
+
+/* Runtime performance counters header file */
+#include "server_stats.h"
+
+/* CM55 offload pipeline header file */
+#include "ipc_offload.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+#define SERVER_STATS_RUNTIME_MASK                      ((1UL << SERVER_STATS_RUNTIME_SHIFT) - 1UL)
+
+#define SERVER_STATS_PERMILLE                          (1000U)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Event counters and high-water marks. */
+atomic_uint_least32_t server_stats_counters[SERVER_STATS_COUNTER_COUNT];
+atomic_uint_least32_t server_stats_hwm[SERVER_STATS_HWM_COUNT];
+
+/* Handshake duration histogram. A handshake falls in the first bucket whose
+ * upper bound, in milliseconds, is above its duration; the last bucket has no
+ * bound. */
+static atomic_uint_least32_t handshake_histogram[SERVER_STATS_HANDSHAKE_BUCKETS];
+static const uint32_t handshake_bucket_bounds_ms[SERVER_STATS_HANDSHAKE_BUCKETS - 1U] =
+{
+    50U, 100U, 200U, 500U, 1000U, 2000U, 5000U
+};
+
+/* Receive calls and records sent per second, updated every
+ * SERVER_STATS_RATE_PERIOD_MS. */
+static TimerHandle_t rate_timer;
+static volatile uint32_t recv_calls_rate;
+static volatile uint32_t records_out_rate;
+static uint32_t recv_calls_last;
+static uint32_t records_out_last;
+
+/* Run time counter of FreeRTOS, extended from the DWT cycle counter. */
+static uint32_t runtime_last_cycles;
+static uint32_t runtime_residual;
+static uint32_t runtime_counter;
+
+/* Task state of the previous snapshot, used to report the CPU load of each
+ * task over the interval between two snapshots. */
+static SemaphoreHandle_t snapshot_mutex;
+static TaskStatus_t task_status[SERVER_STATS_MAX_TASKS];
+static UBaseType_t prev_task_number[SERVER_STATS_MAX_TASKS];
+static uint32_t prev_task_runtime[SERVER_STATS_MAX_TASKS];
+static uint32_t prev_task_count;
+static uint32_t prev_total_runtime;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void server_stats_rate_callback(TimerHandle_t timer);
+static uint8_t *server_stats_put_u32(uint8_t *out, uint32_t value);
+static uint8_t *server_stats_put_u16(uint8_t *out, uint16_t value);
+static uint8_t *server_stats_put_tasks(uint8_t *out);
+
+/*******************************************************************************
+ * Function Name: server_stats_init
+ *******************************************************************************
+ * Summary:
+ *  Creates the snapshot mutex and starts the timer computing the rates.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_rslt_t: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t server_stats_init(void)
+{
+    snapshot_mutex = xSemaphoreCreateMutex();
+    if(NULL == snapshot_mutex)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    rate_timer = xTimerCreate("Stats timer", pdMS_TO_TICKS(SERVER_STATS_RATE_PERIOD_MS),
+                              pdTRUE, NULL, server_stats_rate_callback);
+    if((NULL == rate_timer) || (pdPASS != xTimerStart(rate_timer, 0U)))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_record_handshake
+ *******************************************************************************
+ * Summary:
+ *  Adds a successful handshake to the duration histogram.
+ *
+ * Parameters:
+ *  uint32_t duration_ms: Duration of the handshake
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void server_stats_record_handshake(uint32_t duration_ms)
+{
+    uint32_t bucket = 0U;
+
+    while((bucket < (SERVER_STATS_HANDSHAKE_BUCKETS - 1U)) &&
+          (duration_ms >= handshake_bucket_bounds_ms[bucket]))
+    {
+        bucket++;
+    }
+
+    atomic_fetch_add_explicit(&handshake_histogram[bucket], 1U, memory_order_relaxed);
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_snapshot
+ *******************************************************************************
+ * Summary:
+ *  Writes a snapshot of every counter, in the layout documented at
+ *  SERVER_STATS_SNAPSHOT_MAX_LEN. The CPU load of the tasks is measured since
+ *  the previous snapshot, or since boot for the first one.
+ *
+ * Parameters:
+ *  uint8_t *buffer: Destination of the snapshot
+ *  uint32_t size: Size of the buffer
+ *
+ * Return:
+ *  uint32_t: Length of the snapshot, or 0 if the buffer is too small.
+ *
+ *******************************************************************************/
+uint32_t server_stats_snapshot(uint8_t *buffer, uint32_t size)
+{
+    ipc_offload_stats_t offload;
+    uint8_t *out = buffer;
+    uint32_t index;
+
+    if(size < SERVER_STATS_SNAPSHOT_MAX_LEN)
+    {
+        return 0U;
+    }
+
+    *out++ = SERVER_STATS_SNAPSHOT_VERSION;
+    out = server_stats_put_u32(out, (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS));
+
+    *out++ = SERVER_STATS_COUNTER_COUNT;
+    for(index = 0; index < SERVER_STATS_COUNTER_COUNT; index++)
+    {
+        out = server_stats_put_u32(out, atomic_load_explicit(&server_stats_counters[index],
+                                                             memory_order_relaxed));
+    }
+
+    out = server_stats_put_u32(out, recv_calls_rate);
+    out = server_stats_put_u32(out, records_out_rate);
+
+    *out++ = SERVER_STATS_HANDSHAKE_BUCKETS;
+    for(index = 0; index < SERVER_STATS_HANDSHAKE_BUCKETS; index++)
+    {
+        out = server_stats_put_u32(out, atomic_load_explicit(&handshake_histogram[index],
+                                                             memory_order_relaxed));
+    }
+
+    *out++ = SERVER_STATS_HWM_COUNT;
+    for(index = 0; index < SERVER_STATS_HWM_COUNT; index++)
+    {
+        out = server_stats_put_u32(out, atomic_load_explicit(&server_stats_hwm[index],
+                                                             memory_order_relaxed));
+    }
+
+    ipc_offload_get_stats(&offload);
+    out = server_stats_put_u32(out, offload.offloaded);
+    out = server_stats_put_u32(out, offload.fallbacks);
+    *out++ = IPC_OFFLOAD_CORE_COUNT;
+    for(index = 0; index < IPC_OFFLOAD_CORE_COUNT; index++)
+    {
+        out = server_stats_put_u16(out, (uint16_t)offload.sessions[index]);
+        out = server_stats_put_u16(out, (uint16_t)offload.load[index]);
+    }
+
+    xSemaphoreTake(snapshot_mutex, portMAX_DELAY);
+    out = server_stats_put_tasks(out);
+    xSemaphoreGive(snapshot_mutex);
+
+    return (uint32_t)(out - buffer);
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_put_tasks
+ *******************************************************************************
+ * Summary:
+ *  Writes the task count and the name, CPU load and stack high-water mark of
+ *  every task, and keeps the run time counters for the next snapshot. Must be
+ *  called with the snapshot mutex held.
+ *
+ *  The DWT cycle counter stops while the core is in Deep Sleep, which tickless
+ *  idle enters whenever no task is ready. The load of a task is therefore its
+ *  share of the cycles the core was awake, not of the wall-clock interval, and
+ *  the idle task only accounts for the time spent idle without sleeping.
+ *
+ * Parameters:
+ *  uint8_t *out: Write position in the snapshot
+ *
+ * Return:
+ *  uint8_t *: Write position following the task list.
+ *
+ *******************************************************************************/
+static uint8_t *server_stats_put_tasks(uint8_t *out)
+{
+    uint32_t task_count;
+    uint32_t total_runtime;
+    uint32_t elapsed;
+    uint32_t delta;
+    uint32_t index;
+    uint32_t prev;
+    uint32_t permille;
+
+    /* Returns 0 when more than SERVER_STATS_MAX_TASKS tasks exist. */
+    task_count = (uint32_t)uxTaskGetSystemState(task_status, SERVER_STATS_MAX_TASKS,
+                                                &total_runtime);
+    elapsed = total_runtime - prev_total_runtime;
+
+    *out++ = (uint8_t)task_count;
+    for(index = 0; index < task_count; index++)
+    {
+        delta = task_status[index].ulRunTimeCounter;
+        for(prev = 0; prev < prev_task_count; prev++)
+        {
+            if(prev_task_number[prev] == task_status[index].xTaskNumber)
+            {
+                delta -= prev_task_runtime[prev];
+                break;
+            }
+        }
+
+        permille = (0U == elapsed) ? 0U :
+                   (uint32_t)(((uint64_t)delta * SERVER_STATS_PERMILLE) / elapsed);
+
+        memset(out, 0, SERVER_STATS_TASK_NAME_LEN);
+        strncpy((char *)out, task_status[index].pcTaskName, SERVER_STATS_TASK_NAME_LEN);
+        out += SERVER_STATS_TASK_NAME_LEN;
+        out = server_stats_put_u16(out, (uint16_t)permille);
+        /* No task is ever deleted, so the handle is still valid here. */
+        out = server_stats_put_u16(out, (uint16_t)(uxTaskGetStackHighWaterMark(
+                                       task_status[index].xHandle) * sizeof(StackType_t)));
+    }
+
+    for(index = 0; index < task_count; index++)
+    {
+        prev_task_number[index] = task_status[index].xTaskNumber;
+        prev_task_runtime[index] = task_status[index].ulRunTimeCounter;
+    }
+    prev_task_count = task_count;
+    prev_total_runtime = total_runtime;
+
+    return out;
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_put_u32
+ *******************************************************************************
+ * Summary:
+ *  Writes a big-endian 32-bit value.
+ *
+ * Parameters:
+ *  uint8_t *out: Write position
+ *  uint32_t value: Value to write
+ *
+ * Return:
+ *  uint8_t *: Write position following the value.
+ *
+ *******************************************************************************/
+static uint8_t *server_stats_put_u32(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+
+    return &out[4];
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_put_u16
+ *******************************************************************************
+ * Summary:
+ *  Writes a big-endian 16-bit value.
+ *
+ * Parameters:
+ *  uint8_t *out: Write position
+ *  uint16_t value: Value to write
+ *
+ * Return:
+ *  uint8_t *: Write position following the value.
+ *
+ *******************************************************************************/
+static uint8_t *server_stats_put_u16(uint8_t *out, uint16_t value)
+{
+    out[0] = (uint8_t)(value >> 8);
+    out[1] = (uint8_t)value;
+
+    return &out[2];
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_rate_callback
+ *******************************************************************************
+ * Summary:
+ *  Timer callback computing the per second rates. It also reads the
+ *  run time counter, which must happen at least once per wrap of the DWT
+ *  cycle counter for the extension to stay correct.
+ *
+ * Parameters:
+ *  TimerHandle_t timer: Expired timer (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void server_stats_rate_callback(TimerHandle_t timer)
+{
+    uint32_t recv_calls;
+    uint32_t records_out;
+
+    CY_UNUSED_PARAMETER(timer);
+
+    recv_calls = atomic_load_explicit(&server_stats_counters[SERVER_STATS_RECV_CALLS],
+                                      memory_order_relaxed);
+    records_out = atomic_load_explicit(&server_stats_counters[SERVER_STATS_RECORDS_OUT],
+                                       memory_order_relaxed);
+
+    recv_calls_rate = ((recv_calls - recv_calls_last) * 1000U) / SERVER_STATS_RATE_PERIOD_MS;
+    records_out_rate = ((records_out - records_out_last) * 1000U) / SERVER_STATS_RATE_PERIOD_MS;
+    recv_calls_last = recv_calls;
+    records_out_last = records_out;
+
+    (void)server_stats_runtime_counter();
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_runtime_init
+ *******************************************************************************
+ * Summary:
+ *  Starts the DWT cycle counter the FreeRTOS run time statistics are based
+ *  on. Called by the scheduler through portCONFIGURE_TIMER_FOR_RUN_TIME_STATS.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void server_stats_runtime_init(void)
+{
+    (void)cycle_counter_init();
+    runtime_last_cycles = cycle_counter_read();
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_runtime_counter
+ *******************************************************************************
+ * Summary:
+ *  Returns the run time counter of FreeRTOS. Called by the scheduler on every
+ *  context switch through portGET_RUN_TIME_COUNTER_VALUE, so it only uses
+ *  32-bit arithmetic.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t: CPU cycles since the scheduler started, divided by
+ *  2^SERVER_STATS_RUNTIME_SHIFT.
+ *
+ *******************************************************************************/
+uint32_t server_stats_runtime_counter(void)
+{
+    UBaseType_t interrupt_mask;
+    uint32_t cycles;
+    uint32_t delta;
+    uint32_t counter;
+
+    interrupt_mask = taskENTER_CRITICAL_FROM_ISR();
+    cycles = cycle_counter_read();
+    delta = cycles - runtime_last_cycles;
+    runtime_last_cycles = cycles;
+
+    runtime_residual += delta & SERVER_STATS_RUNTIME_MASK;
+    runtime_counter += (delta >> SERVER_STATS_RUNTIME_SHIFT) +
+                       (runtime_residual >> SERVER_STATS_RUNTIME_SHIFT);
+    runtime_residual &= SERVER_STATS_RUNTIME_MASK;
+    counter = runtime_counter;
+    taskEXIT_CRITICAL_FROM_ISR(interrupt_mask);
+
+    return counter;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,236 @@
+/******************************************************************************
+* File Name:   server_stats.h
+*
+* Description: This file is the public interface of server_stats.c, the
+* runtime performance counters of the secure TCP server.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SERVER_STATS_H_
+#define SERVER_STATS_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdatomic.h>
+#include "cy_result.h"
+
+/* CM55 offload pipeline header file, for the number of cores */
+#include "ipc_offload.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Version of the snapshot layout written by server_stats_snapshot(). */
+#define SERVER_STATS_SNAPSHOT_VERSION             (5U)
+
+/* Number of handshake duration histogram buckets. */
+#define SERVER_STATS_HANDSHAKE_BUCKETS            (8U)
+
+/* Maximum number of tasks whose CPU load is reported. The per-task figures
+ * are left out of the snapshot if the system runs more tasks than this. */
+#define SERVER_STATS_MAX_TASKS                    (24U)
+
+/* Length of the task names reported in a snapshot. Longer names are
+ * truncated and shorter ones are padded with zeros. */
+#define SERVER_STATS_TASK_NAME_LEN                (8U)
+
+/* The run time counter of FreeRTOS advances once every 2^SHIFT CPU cycles, so
+ * that the 32-bit counter covers several minutes between two snapshots. */
+#define SERVER_STATS_RUNTIME_SHIFT                (8U)
+
+/* Period over which the per second rates are computed. */
+#define SERVER_STATS_RATE_PERIOD_MS               (1000U)
+
+/* Largest snapshot written by server_stats_snapshot(). All multi-byte fields
+ * are big-endian:
+ *  u8  version
+ *  u32 uptime in milliseconds
+ *  u8  number of counters, u32 counters[]
+ *  u32 receive calls per second, u32 records sent per second
+ *  u8  number of histogram buckets, u32 buckets[]
+ *  u8  number of high-water marks, u32 high-water marks[]
+ *  u32 requests offloaded to CM55, u32 requests executed on CM33
+ *  u8  number of cores (CM33, then CM55), then per core: u16 sessions
+ *      attached and u16 CPU load in permille of the wall-clock time, see
+ *      ipc_offload_stats_t
+ *  u8  number of tasks, then per task: char name[SERVER_STATS_TASK_NAME_LEN]
+ *      u16 CPU load in permille since the previous snapshot, and u16 least
+ *      stack space in bytes the task has had free since it started. The
+ *      load is a share of the cycles the core was awake: the DWT cycle
+ *      counter it is based on stops in Deep Sleep.
+ */
+#define SERVER_STATS_SNAPSHOT_MAX_LEN             (1U + 4U + 1U + (4U * SERVER_STATS_COUNTER_COUNT) + \
+                                                   8U + 1U + (4U * SERVER_STATS_HANDSHAKE_BUCKETS) + \
+                                                   1U + (4U * SERVER_STATS_HWM_COUNT) + 8U + \
+                                                   1U + (4U * IPC_OFFLOAD_CORE_COUNT) + 1U + \
+                                                   ((SERVER_STATS_TASK_NAME_LEN + 4U) * \
+                                                    SERVER_STATS_MAX_TASKS))
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Event counters. */
+typedef enum
+{
+    SERVER_STATS_ACCEPTS = 0,
+    SERVER_STATS_HANDSHAKE_FAILURES,
+    SERVER_STATS_SESSIONS_REJECTED,
+    SERVER_STATS_BYTES_IN,
+    SERVER_STATS_BYTES_OUT,
+    /* Calls to cy_socket_recv() that returned data. The secure socket layer
+     * hides TLS record boundaries, so one call may return several records or
+     * a part of one. */
+    SERVER_STATS_RECV_CALLS,
+    /* Transmit batches sent; a batch always fits in one TLS record. */
+    SERVER_STATS_RECORDS_OUT,
+    /* Times the server listened again after the Ethernet link came up. */
+    SERVER_STATS_LINK_UPS,
+    /* mbedTLS allocations served by the heap because no pool had a free
+     * block large enough, see mem_pool.h. */
+    SERVER_STATS_POOL_FALLBACKS,
+    /* Sessions closed for being idle, or to make room for a new client. */
+    SERVER_STATS_SESSIONS_EVICTED,
+    /* Frames dropped because both transmit batch buffers of the session were
+     * taken, one being sent and the other full. */
+    SERVER_STATS_TX_DROPS,
+    SERVER_STATS_COUNTER_COUNT
+} server_stats_counter_t;
+
+/* High-water marks. */
+typedef enum
+{
+    SERVER_STATS_HWM_RX_BUFFER = 0,
+    SERVER_STATS_HWM_TX_BATCH,
+    SERVER_STATS_HWM_ACCEPT_QUEUE,
+    /* Longest time, in milliseconds, from the start of the connection attempt
+     * that brought the link up to listening on it. */
+    SERVER_STATS_HWM_TIME_TO_LISTEN,
+    /* Blocks in use in each memory pool. */
+    SERVER_STATS_HWM_POOL_SMALL,
+    SERVER_STATS_HWM_POOL_MEDIUM,
+    SERVER_STATS_HWM_POOL_LARGE,
+    SERVER_STATS_HWM_POOL_RECORD_OUT,
+    SERVER_STATS_HWM_POOL_RECORD_IN,
+    /* lwIP pool entries and heap bytes in use, see net_profile.h. */
+    SERVER_STATS_HWM_PBUF_POOL,
+    SERVER_STATS_HWM_TCP_PCB,
+    SERVER_STATS_HWM_TCP_SEG,
+    SERVER_STATS_HWM_LWIP_HEAP,
+    SERVER_STATS_HWM_COUNT
+} server_stats_hwm_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Counter storage, only accessed through the functions below. */
+extern atomic_uint_least32_t server_stats_counters[SERVER_STATS_COUNTER_COUNT];
+extern atomic_uint_least32_t server_stats_hwm[SERVER_STATS_HWM_COUNT];
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t server_stats_init(void);
+void server_stats_record_handshake(uint32_t duration_ms);
+uint32_t server_stats_snapshot(uint8_t *buffer, uint32_t size);
+
+/* Hooks of the FreeRTOS run time statistics, see FreeRTOSConfig.h. */
+void server_stats_runtime_init(void);
+uint32_t server_stats_runtime_counter(void);
+
+/*******************************************************************************
+ * Function Name: server_stats_add
+ *******************************************************************************
+ * Summary:
+ *  Adds to an event counter. Safe to call from any task or interrupt.
+ *
+ * Parameters:
+ *  server_stats_counter_t counter: Counter to update
+ *  uint32_t value: Amount to add
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static inline void server_stats_add(server_stats_counter_t counter, uint32_t value)
+{
+    atomic_fetch_add_explicit(&server_stats_counters[counter], value,
+                              memory_order_relaxed);
+}
+
+/*******************************************************************************
+ * Function Name: server_stats_track
+ *******************************************************************************
+ * Summary:
+ *  Raises a high-water mark to the given level if it is above the current
+ *  mark. Safe to call from any task or interrupt.
+ *
+ * Parameters:
+ *  server_stats_hwm_t hwm: High-water mark to update
+ *  uint32_t level: Current level
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static inline void server_stats_track(server_stats_hwm_t hwm, uint32_t level)
+{
+    uint_least32_t mark = atomic_load_explicit(&server_stats_hwm[hwm],
+                                               memory_order_relaxed);
+
+    while((level > mark) &&
+          !atomic_compare_exchange_weak_explicit(&server_stats_hwm[hwm], &mark, level,
+                                                 memory_order_relaxed,
+                                                 memory_order_relaxed))
+    {
+    }
+}
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* SERVER_STATS_H_ */
+
+/* [] END OF FILE */
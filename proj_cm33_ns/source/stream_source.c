@@ -0,0 +1,206 @@
+/******************************************************************************
+* File Name:   stream_source.c
+*
+* Description: This file contains the double-buffered block producer feeding
+* the streaming sessions. A producer task fills a block while the stream task
+* sends the other one; the blocks move between them through two queues of
+* block pointers. The data is a counting pattern generated in RAM, standing in
+* for sensor samples.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+
+/* Standard C header file */
+#include <string.h>
+
+/* Stream source header file */
+#include "stream_source.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Blocks, with the headroom in front of the data. Word aligned so that the
+ * TLS layer copies them with word accesses. */
+static uint8_t stream_source_blocks[STREAM_SOURCE_BUFFER_COUNT]
+                                   [STREAM_SOURCE_HEADROOM + STREAM_SOURCE_BLOCK_LEN]
+                                   __attribute__((aligned(4)));
+
+/* Blocks waiting to be filled, and blocks filled and waiting to be sent. */
+static QueueHandle_t stream_source_free;
+static QueueHandle_t stream_source_ready;
+
+/* Function told about every filled block. */
+static stream_source_callback_t stream_source_callback;
+
+/*******************************************************************************
+ * Function Name: stream_source_task
+ *******************************************************************************
+ * Summary:
+ *  Producer task. Fills every free block with the next samples, hands it
+ *  over to the stream task and calls the callback, so that a stream waiting
+ *  for a block is woken.
+ *
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void stream_source_task(void *arg)
+{
+    uint8_t *block;
+    uint8_t sample = 0U;
+    uint32_t index;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while(true)
+    {
+        (void)xQueueReceive(stream_source_free, &block, portMAX_DELAY);
+
+        for(index = 0; index < STREAM_SOURCE_BLOCK_LEN; index++)
+        {
+            block[STREAM_SOURCE_HEADROOM + index] = sample++;
+        }
+
+        (void)xQueueSend(stream_source_ready, &block, portMAX_DELAY);
+
+        if(NULL != stream_source_callback)
+        {
+            stream_source_callback();
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: stream_source_init
+ *******************************************************************************
+ * Summary:
+ *  Creates the block queues and the producer task, and hands every block to
+ *  the producer.
+ *
+ * Parameters:
+ *  stream_source_callback_t callback: Function told about every filled block
+ *
+ * Return:
+ *  cy_rslt_t: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t stream_source_init(stream_source_callback_t callback)
+{
+    uint8_t *block;
+    uint32_t index;
+
+    stream_source_callback = callback;
+
+    stream_source_free = xQueueCreate(STREAM_SOURCE_BUFFER_COUNT, sizeof(uint8_t *));
+    stream_source_ready = xQueueCreate(STREAM_SOURCE_BUFFER_COUNT, sizeof(uint8_t *));
+    if((NULL == stream_source_free) || (NULL == stream_source_ready))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    for(index = 0; index < STREAM_SOURCE_BUFFER_COUNT; index++)
+    {
+        block = stream_source_blocks[index];
+        (void)xQueueSend(stream_source_free, &block, 0U);
+    }
+
+    if(pdPASS != xTaskCreate(stream_source_task, "Producer task",
+                             STREAM_SOURCE_TASK_STACK_SIZE, NULL,
+                             STREAM_SOURCE_TASK_PRIORITY, NULL))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: stream_source_acquire
+ *******************************************************************************
+ * Summary:
+ *  Takes the oldest filled block. The caller owns it until it releases it.
+ *
+ * Parameters:
+ *  TickType_t wait: Ticks to wait for a filled block
+ *
+ * Return:
+ *  uint8_t *: Start of the block, STREAM_SOURCE_HEADROOM bytes before its
+ *  data, or NULL if no block was filled in time.
+ *
+ *******************************************************************************/
+uint8_t *stream_source_acquire(TickType_t wait)
+{
+    uint8_t *block;
+
+    if(pdTRUE != xQueueReceive(stream_source_ready, &block, wait))
+    {
+        return NULL;
+    }
+
+    return block;
+}
+
+/*******************************************************************************
+ * Function Name: stream_source_release
+ *******************************************************************************
+ * Summary:
+ *  Returns a sent block to the producer to be filled again.
+ *
+ * Parameters:
+ *  uint8_t *block: Block returned by stream_source_acquire()
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void stream_source_release(uint8_t *block)
+{
+    (void)xQueueSend(stream_source_free, &block, 0U);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name:   stream_source.h
+*
+* Description: This file contains the declarations of the double-buffered
+* block producer feeding the streaming sessions.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STREAM_SOURCE_H_
+#define STREAM_SOURCE_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_result.h"
+#include <FreeRTOS.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Sensor data carried by one block. A block goes out as one frame, which
+ * must fit one TLS record of MBEDTLS_SSL_OUT_CONTENT_LEN bytes. */
+#define STREAM_SOURCE_BLOCK_LEN                   (1024U)
+
+/* Bytes reserved in front of the data of every block, for the frame header
+ * and the block sequence number, so that the block is sent without a copy. */
+#define STREAM_SOURCE_HEADROOM                    (8U)
+
+/* Number of blocks. With two, the producer fills one while the other is
+ * being sent. */
+#define STREAM_SOURCE_BUFFER_COUNT                (2U)
+
+/* Task filling the blocks. */
+#define STREAM_SOURCE_TASK_STACK_SIZE             (1024U)
+#define STREAM_SOURCE_TASK_PRIORITY               (1U)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Function called by the producer task every time it has filled a block. */
+typedef void (*stream_source_callback_t)(void);
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t stream_source_init(stream_source_callback_t callback);
+uint8_t *stream_source_acquire(TickType_t wait);
+void stream_source_release(uint8_t *block);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* STREAM_SOURCE_H_ */
+
+/* [] END OF FILE */
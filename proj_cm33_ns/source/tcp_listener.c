@@ -0,0 +1,889 @@
+/******************************************************************************
+* File Name:   tcp_listener.c
+*
+* Description: This file contains the listening sockets of the secure TCP server and
+* the handshake workers that accept the clients and negotiate TLS.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+
+/* Standard C header file */
+#include <string.h>
+/* To use the portable formatting macros */
+#include <inttypes.h>
+
+/* Secure socket header file. */
+#include "cy_secure_sockets.h"
+
+/* IP address related header files (part of the lwIP TCP/IP stack). */
+#include "ip_addr.h"
+
+/* Secure TCP server header file */
+#include "secure_tcp_server.h"
+
+/* Session table header file */
+#include "tcp_session.h"
+
+/* Listener header file */
+#include "tcp_listener.h"
+
+/* Runtime performance counters header file */
+#include "server_stats.h"
+
+/* Deferred logger header file */
+#include "app_log.h"
+
+/* CM55 offload pipeline header file */
+#include "ipc_offload.h"
+
+/* Shared application state header file */
+#include "app_state.h"
+
+/* Trace ring header file */
+#include "trace_ring.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Limit of the pending accept count. It only needs to be above the number of
+ * connections lwIP can hold in its listen backlog. */
+#define TCP_ACCEPT_PENDING_MAX                         (0xFFFFU)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Listening socket of one address family. pending counts the connections of
+ * this socket that wait in its backlog for a handshake worker, and users the
+ * workers accepting on it; both are updated in critical sections, as the
+ * connect callback and the workers use them too. */
+typedef struct
+{
+    const char *name;
+    int domain;
+    cy_socket_ip_version_t version;
+    cy_socket_sockaddr_t addr;
+    cy_socket_t handle;
+    uint32_t pending;
+    uint32_t users;
+} tcp_listener_t;
+
+/* Listening socket closed while workers were still accepting on it. It is
+ * deleted by the last of these workers. */
+typedef struct
+{
+    cy_socket_t handle;
+    uint32_t users;
+} tcp_listener_retired_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+
+cy_rslt_t create_secure_tcp_server_socket(tcp_listener_t *listener);
+cy_rslt_t tcp_connection_handler(cy_socket_t socket_handle, void *arg);
+static bool tcp_listener_address(const tcp_listener_t *listener,
+                                 const eth_link_status_t *status,
+                                 cy_socket_ip_address_t *address);
+static void tcp_listener_close(tcp_listener_t *listener);
+static tcp_listener_t *tcp_listener_take_pending(cy_socket_t *handle);
+static void tcp_listener_put(tcp_listener_t *listener, cy_socket_t handle);
+static void tcp_handshake_worker_task(void *arg);
+static cy_rslt_t tcp_session_accept(cy_socket_t socket_handle);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Listening sockets. Both address families are served at once and share
+ * the TLS identity, the handshake workers and the session table. */
+static tcp_listener_t tcp_listeners[] =
+{
+#if (TCP_SERVER_IPV4_ENABLE)
+    { .name = "IPv4", .domain = CY_SOCKET_DOMAIN_AF_INET, .version = CY_SOCKET_IP_VER_V4 },
+#endif
+#if (TCP_SERVER_IPV6_ENABLE)
+    { .name = "IPv6", .domain = CY_SOCKET_DOMAIN_AF_INET6, .version = CY_SOCKET_IP_VER_V6 },
+#endif
+};
+
+#define TCP_LISTENER_COUNT        (sizeof(tcp_listeners) / sizeof(tcp_listeners[0]))
+
+_Static_assert((TCP_SERVER_IPV4_ENABLE) || (TCP_SERVER_IPV6_ENABLE),
+               "At least one address family must be enabled");
+
+/* Number of connections waiting in the listen backlog for a handshake
+ * worker. Every connect event gives the semaphore once and every accept
+ * takes it once, so each backlog entry is accepted exactly once and in
+ * order, whatever the number of busy workers. */
+static SemaphoreHandle_t tcp_accept_pending;
+
+/* Closed listening sockets still in use. Every entry has at least one user
+ * and a worker uses one socket at a time, while the socket that was closed
+ * last also had a user, so one entry per worker is always enough. */
+static tcp_listener_retired_t tcp_listeners_retired[TCP_SERVER_HANDSHAKE_WORKERS];
+
+/* Number of handshake workers currently negotiating. */
+static volatile uint32_t handshake_workers_busy;
+
+/*******************************************************************************
+ * Function Name: tcp_listener_address
+ *******************************************************************************
+ * Summary:
+ *  Gets the address the interface has now in the address family of a
+ *  listener.
+ *
+ * Parameters:
+ *  const tcp_listener_t *listener: Listener whose family is looked up
+ *  const eth_link_status_t *status: Current link state
+ *  cy_socket_ip_address_t *address: Filled in with the address
+ *
+ * Return:
+ *  bool: true if the interface has an address in that family.
+ *
+ *******************************************************************************/
+static bool tcp_listener_address(const tcp_listener_t *listener,
+                                 const eth_link_status_t *status,
+                                 cy_socket_ip_address_t *address)
+{
+    memset(address, 0, sizeof(*address));
+    address->version = listener->version;
+
+    if(CY_SOCKET_IP_VER_V6 == listener->version)
+    {
+        if(!status->ipv6_valid)
+        {
+            return false;
+        }
+        memcpy(address->ip.v6, status->ipv6.ip.v6, sizeof(address->ip.v6));
+    }
+    else
+    {
+        address->ip.v4 = status->ipv4.ip.v4;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_listener_close
+ *******************************************************************************
+ * Summary:
+ *  Deletes the socket of a listener. The connections still waiting in its
+ *  backlog are dropped with it. A socket that handshake workers are still
+ *  accepting on is retired instead, and deleted by the last of them.
+ *
+ * Parameters:
+ *  tcp_listener_t *listener: Listener to close
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_listener_close(tcp_listener_t *listener)
+{
+    cy_socket_t handle;
+    uint32_t index;
+
+    taskENTER_CRITICAL();
+    handle = listener->handle;
+    listener->handle = NULL;
+    listener->pending = 0U;
+    if((NULL != handle) && (0U != listener->users))
+    {
+        for(index = 0U; index < TCP_SERVER_HANDSHAKE_WORKERS; index++)
+        {
+            if(NULL == tcp_listeners_retired[index].handle)
+            {
+                tcp_listeners_retired[index].handle = handle;
+                tcp_listeners_retired[index].users = listener->users;
+                handle = NULL;
+                break;
+            }
+        }
+        listener->users = 0U;
+    }
+    taskEXIT_CRITICAL();
+
+    if(NULL != handle)
+    {
+        cy_socket_delete(handle);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_server_listen
+ *******************************************************************************
+ * Summary:
+ *  Makes sure every address family listens on the address the interface has
+ *  now in that family. A listening socket is kept if it is already bound to
+ *  that address, created again if the address changed, and closed if the
+ *  family has no address. The first call after the link came up records the
+ *  time from the start of the connection attempt to listening.
+ *
+ * Parameters:
+ *  const eth_link_status_t *status: Current link state, with the link up
+ *
+ * Return:
+ *  cy_rslt_t: CY_RSLT_SUCCESS if at least one family is listening.
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_server_listen(const eth_link_status_t *status)
+{
+    static uint32_t listening_up_count;
+    cy_rslt_t result;
+    tcp_listener_t *listener;
+    cy_socket_ip_address_t address;
+    uint32_t listening = 0U;
+    uint32_t time_to_listen_ms;
+    uint32_t index;
+
+    for(index = 0; index < TCP_LISTENER_COUNT; index++)
+    {
+        listener = &tcp_listeners[index];
+
+        if(!tcp_listener_address(listener, status, &address))
+        {
+            if(NULL != listener->handle)
+            {
+                APP_LOG_INFO("%s address lost, closing the %s server socket\n",
+                             listener->name, listener->name);
+                tcp_listener_close(listener);
+            }
+            continue;
+        }
+
+        if((NULL != listener->handle) &&
+           ((CY_SOCKET_IP_VER_V6 == address.version) ?
+            (0 == memcmp(listener->addr.ip_address.ip.v6, address.ip.v6,
+                         sizeof(address.ip.v6))) :
+            (listener->addr.ip_address.ip.v4 == address.ip.v4)))
+        {
+            listening++;
+            continue;
+        }
+
+        if(NULL != listener->handle)
+        {
+            APP_LOG_INFO("%s address changed, creating the %s server socket again\n",
+                         listener->name, listener->name);
+            tcp_listener_close(listener);
+        }
+
+        /* IP address and TCP port number of the TCP server */
+        listener->addr.ip_address = address;
+        listener->addr.port = TCP_SERVER_PORT;
+
+        /* Create secure TCP server socket. */
+        result = create_secure_tcp_server_socket(listener);
+        if(CY_RSLT_SUCCESS == result)
+        {
+            /* Start listening on the secure TCP socket. */
+            result = cy_socket_listen(listener->handle, TCP_SERVER_MAX_PENDING_CONNECTIONS);
+            if(CY_RSLT_SUCCESS != result)
+            {
+                printf("cy_socket_listen returned error. Error: %"PRIu32"\n", result);
+            }
+        }
+
+        if(CY_RSLT_SUCCESS != result)
+        {
+            APP_LOG_ERROR("%s server socket not listening\n", listener->name);
+            tcp_listener_close(listener);
+            continue;
+        }
+
+        listening++;
+    }
+
+    if(0U == listening)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    if(listening_up_count != status->up_count)
+    {
+        listening_up_count = status->up_count;
+        time_to_listen_ms = (uint32_t)((xTaskGetTickCount() - status->up_tick) *
+                                       portTICK_PERIOD_MS);
+        server_stats_add(SERVER_STATS_LINK_UPS, 1U);
+        server_stats_track(SERVER_STATS_HWM_TIME_TO_LISTEN, time_to_listen_ms);
+        APP_LOG_INFO("Listening %"PRIu32" ms after the link came up\n", time_to_listen_ms);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_server_print_listeners
+ *******************************************************************************
+ * Summary:
+ *  Prints the addresses the server listens on.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_server_print_listeners(void)
+{
+    const tcp_listener_t *listener;
+    char addr_text[IPADDR_STRLEN_MAX];
+    uint32_t index;
+
+    for(index = 0; index < TCP_LISTENER_COUNT; index++)
+    {
+        listener = &tcp_listeners[index];
+        if(NULL == listener->handle)
+        {
+            printf("Not listening on %s: no address assigned\n", listener->name);
+            continue;
+        }
+
+        if(CY_SOCKET_IP_VER_V6 == listener->version)
+        {
+            ip6addr_ntoa_r((const ip6_addr_t*)&listener->addr.ip_address.ip.v6,
+                           addr_text, sizeof(addr_text));
+        }
+        else
+        {
+            ip4addr_ntoa_r((const ip4_addr_t*)&listener->addr.ip_address.ip.v4,
+                           addr_text, sizeof(addr_text));
+        }
+        printf("Listening for incoming TCP client connection on %s %s, Port: %u\n",
+               listener->name, addr_text, (unsigned int)listener->addr.port);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: create_secure_tcp_server_socket
+ *******************************************************************************
+ * Summary:
+ *  Function to create a socket and set the socket options for configuring TLS
+ *  identity, socket connection handler, message reception handler and
+ *  socket disconnection handler.
+ *
+* Parameters:
+*  tcp_listener_t *listener: Listener to create the socket for. The socket is
+*   bound to the address of the listener.
+*
+* Return:
+*  cy_result result: Result of the operation.
+*
+*******************************************************************************/
+cy_rslt_t create_secure_tcp_server_socket(tcp_listener_t *listener)
+{
+    cy_rslt_t result;
+    cy_socket_t server_handle;
+
+    /* TCP socket receive timeout period. */
+    uint32_t tcp_recv_timeout = TCP_SERVER_RECV_TIMEOUT_MS;
+
+    /* Variables used to set socket options. */
+    cy_socket_opt_callback_t tcp_receive_option;
+    cy_socket_opt_callback_t tcp_connection_option;
+    cy_socket_opt_callback_t tcp_disconnect_option;
+
+    /* TLS authentication mode.*/
+    cy_socket_tls_auth_mode_t tls_auth_mode = CY_SOCKET_TLS_VERIFY_REQUIRED;
+
+    /* Create a Secure TCP socket. */
+    result = cy_socket_create(listener->domain, CY_SOCKET_TYPE_STREAM,
+                                  CY_SOCKET_IPPROTO_TLS, &server_handle);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed to create socket! Error code: %"PRIu32"\n", result);
+        return result;
+    }
+
+    /* Publish the socket only once it is created, so that the workers never
+     * accept on a stale handle. */
+    taskENTER_CRITICAL();
+    listener->handle = server_handle;
+    listener->pending = 0U;
+    taskEXIT_CRITICAL();
+
+    /* Set the TCP socket receive timeout period. */
+    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_SOCKET,
+                                 CY_SOCKET_SO_RCVTIMEO, &tcp_recv_timeout,
+                                 sizeof(tcp_recv_timeout));
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Set socket option: CY_SOCKET_SO_RCVTIMEO failed! Error code: %"PRIu32"\n", result);
+        return result;
+    }
+
+    /* Register the callback function to handle connection request from a TCP client. */
+    tcp_connection_option.callback = tcp_connection_handler;
+    tcp_connection_option.arg = listener;
+
+    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_SOCKET,
+                                  CY_SOCKET_SO_CONNECT_REQUEST_CALLBACK,
+                                  &tcp_connection_option, sizeof(cy_socket_opt_callback_t));
+    if(result != CY_RSLT_SUCCESS)
+    {
+        printf("Set socket option: CY_SOCKET_SO_CONNECT_REQUEST_CALLBACK failed! Error code: %"PRIu32"\n", result);
+        return result;
+    }
+
+    /* Register the callback function to handle messages received from a TCP client. */
+    tcp_receive_option.callback = tcp_receive_msg_handler;
+    tcp_receive_option.arg = NULL;
+
+    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_SOCKET,
+                                  CY_SOCKET_SO_RECEIVE_CALLBACK,
+                                  &tcp_receive_option, sizeof(cy_socket_opt_callback_t));
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Set socket option: CY_SOCKET_SO_RECEIVE_CALLBACK failed! Error code: %"PRIu32"\n", result);
+        return result;
+    }
+
+    /* Register the callback function to handle disconnection. */
+    tcp_disconnect_option.callback = tcp_disconnection_handler;
+    tcp_disconnect_option.arg = NULL;
+
+    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_SOCKET,
+                                  CY_SOCKET_SO_DISCONNECT_CALLBACK,
+                                  &tcp_disconnect_option, sizeof(cy_socket_opt_callback_t));
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Set socket option: CY_SOCKET_SO_DISCONNECT_CALLBACK failed! Error code: %"PRIu32"\n", result);
+        return result;
+    }
+
+    /* Set the TCP socket to use the TLS identity. */
+    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_TLS, CY_SOCKET_SO_TLS_IDENTITY,
+                                  tls_identity, strlen(tls_identity));
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Failed cy_socket_setsockopt! Error code: %"PRIu32"\n", result);
+        return result;
+    }
+
+    /* Set the TLS authentication mode. */
+    cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_TLS, CY_SOCKET_SO_TLS_AUTH_MODE,
+                        &tls_auth_mode, sizeof(cy_socket_tls_auth_mode_t));
+
+#if (TCP_SERVER_ALPN_ENABLE)
+    /* Offer the application protocols during the handshake. Clients that do
+     * not use ALPN are still served. */
+    result = cy_socket_setsockopt(server_handle, CY_SOCKET_SOL_TLS, CY_SOCKET_SO_ALPN_PROTOCOLS,
+                                  TCP_SERVER_ALPN_PROTOCOLS, strlen(TCP_SERVER_ALPN_PROTOCOLS));
+    if(CY_RSLT_SUCCESS != result)
+    {
+        printf("Set socket option: CY_SOCKET_SO_ALPN_PROTOCOLS failed! Error code: %"PRIu32"\n",
+               result);
+    }
+#endif
+
+     /* Bind the TCP socket created to Server IP address and to TCP port. */
+    result = cy_socket_bind(server_handle, &listener->addr, sizeof(listener->addr));
+    if(result != CY_RSLT_SUCCESS)
+    {
+        printf("Failed to bind to socket! Error code: %"PRIu32"\n", result);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_connection_handler
+ *******************************************************************************
+ * Summary:
+ *  Callback function to handle incoming secure TCP client connection. The TLS
+ *  handshake is not performed here; the pending connection is counted on its
+ *  listener and for the handshake worker pool so that the secure socket
+ *  callback thread keeps serving the established sessions.
+ *
+ * Parameters:
+ * cy_socket_t socket_handle: Connection handle for the TCP server socket
+ *  void *args : Listener of the TCP server socket
+ *
+ * Return:
+ *  cy_result result: Result of the operation
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_connection_handler(cy_socket_t socket_handle, void *arg)
+{
+    tcp_listener_t *listener = (tcp_listener_t *)arg;
+    bool counted = false;
+
+    trace_point(TRACE_EVENT_ACCEPT_READY, TRACE_NO_SESSION, 0U);
+
+    taskENTER_CRITICAL();
+    if(socket_handle == listener->handle)
+    {
+        listener->pending++;
+        counted = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if(!counted)
+    {
+        /* The listener was closed meanwhile. */
+        return CY_RSLT_SUCCESS;
+    }
+
+    if(pdTRUE != xSemaphoreGive(tcp_accept_pending))
+    {
+        taskENTER_CRITICAL();
+        if((socket_handle == listener->handle) && (0U != listener->pending))
+        {
+            listener->pending--;
+        }
+        taskEXIT_CRITICAL();
+        APP_LOG_ERROR("Pending accept count saturated at %u\n", TCP_ACCEPT_PENDING_MAX);
+    }
+    server_stats_track(SERVER_STATS_HWM_ACCEPT_QUEUE,
+                       (uint32_t)uxSemaphoreGetCount(tcp_accept_pending));
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_listener_take_pending
+ *******************************************************************************
+ * Summary:
+ *  Takes one pending connection off a listener, together with a use of its
+ *  socket that tcp_listener_put() gives back. The listeners are visited in
+ *  turn, so that a burst on one address family does not hold back the other.
+ *
+ * Parameters:
+ *  cy_socket_t *handle: Set to the socket to accept on
+ *
+ * Return:
+ *  tcp_listener_t *: Listener to accept on, or NULL if the connection was
+ *  dropped with a listener that was closed meanwhile.
+ *
+ *******************************************************************************/
+static tcp_listener_t *tcp_listener_take_pending(cy_socket_t *handle)
+{
+    static uint32_t next_listener;
+    tcp_listener_t *listener = NULL;
+    uint32_t index;
+    uint32_t visited;
+
+    taskENTER_CRITICAL();
+    for(visited = 0U; visited < TCP_LISTENER_COUNT; visited++)
+    {
+        index = (next_listener + visited) % TCP_LISTENER_COUNT;
+        if(0U != tcp_listeners[index].pending)
+        {
+            tcp_listeners[index].pending--;
+            tcp_listeners[index].users++;
+            listener = &tcp_listeners[index];
+            *handle = listener->handle;
+            next_listener = (index + 1U) % TCP_LISTENER_COUNT;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return listener;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_listener_put
+ *******************************************************************************
+ * Summary:
+ *  Gives back a use of a listening socket taken by tcp_listener_take_pending()
+ *  and deletes the socket if it was closed meanwhile and this was its last
+ *  user.
+ *
+ * Parameters:
+ *  tcp_listener_t *listener: Listener the socket was taken from
+ *  cy_socket_t handle: Socket that was accepted on
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_listener_put(tcp_listener_t *listener, cy_socket_t handle)
+{
+    cy_socket_t deleted = NULL;
+    uint32_t index;
+
+    taskENTER_CRITICAL();
+    if(handle == listener->handle)
+    {
+        listener->users--;
+    }
+    else
+    {
+        for(index = 0U; index < TCP_SERVER_HANDSHAKE_WORKERS; index++)
+        {
+            if(handle == tcp_listeners_retired[index].handle)
+            {
+                if(0U == --tcp_listeners_retired[index].users)
+                {
+                    deleted = handle;
+                    tcp_listeners_retired[index].handle = NULL;
+                }
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if(NULL != deleted)
+    {
+        cy_socket_delete(deleted);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_handshake_worker_task
+ *******************************************************************************
+ * Summary:
+ *  Handshake worker task. Takes pending connections, accepts them and performs
+ *  the TLS handshake outside of the secure socket callback thread.
+ *
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_handshake_worker_task(void *arg)
+{
+    UBaseType_t pending;
+    tcp_listener_t *listener;
+    cy_socket_t handle = NULL;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while(true)
+    {
+        xSemaphoreTake(tcp_accept_pending, portMAX_DELAY);
+
+        taskENTER_CRITICAL();
+        handshake_workers_busy++;
+        taskEXIT_CRITICAL();
+
+        /* Report the backlog when every worker is busy negotiating. */
+        pending = uxSemaphoreGetCount(tcp_accept_pending);
+        if((TCP_SERVER_HANDSHAKE_WORKERS == handshake_workers_busy) && (pending > 0U))
+        {
+            APP_LOG_WARN("All %u handshake workers busy, %"PRIu32" connection(s) queued\n",
+                         TCP_SERVER_HANDSHAKE_WORKERS, (uint32_t)pending);
+        }
+
+        /* The listener may be closed during the handshake; its socket is
+         * only deleted once every worker using it has put it back. */
+        listener = tcp_listener_take_pending(&handle);
+        if(NULL != listener)
+        {
+            tcp_session_accept(handle);
+            tcp_listener_put(listener, handle);
+        }
+
+        taskENTER_CRITICAL();
+        handshake_workers_busy--;
+        taskEXIT_CRITICAL();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_handshake_pool_init
+ *******************************************************************************
+ * Summary:
+ *  Creates the pending accept count and the handshake worker tasks.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_result result: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_handshake_pool_init(void)
+{
+    uint32_t index;
+
+    tcp_accept_pending = xSemaphoreCreateCounting(TCP_ACCEPT_PENDING_MAX, 0U);
+    if(NULL == tcp_accept_pending)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    for(index = 0; index < TCP_SERVER_HANDSHAKE_WORKERS; index++)
+    {
+        if(pdPASS != xTaskCreate(tcp_handshake_worker_task, "Handshake task",
+                                 TCP_SERVER_HANDSHAKE_TASK_STACK_SIZE, NULL,
+                                 TCP_SERVER_HANDSHAKE_TASK_PRIORITY, NULL))
+        {
+            return CY_RSLT_TYPE_ERROR;
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_accept
+ *******************************************************************************
+ * Summary:
+ *  Accepts a pending connection on a listening socket, performs the TLS
+ *  handshake and binds the client socket to a session slot.
+ *
+ * Parameters:
+ *  cy_socket_t socket_handle: Connection handle for the TCP server socket
+ *
+ * Return:
+ *  cy_result result: Result of the operation
+ *
+ *******************************************************************************/
+static cy_rslt_t tcp_session_accept(cy_socket_t socket_handle)
+{
+    cy_rslt_t result;
+    tcp_session_t *session;
+    TickType_t handshake_ticks;
+
+    /* Variables used to drain a connection that does not fit in the table. */
+    cy_socket_t rejected_handle;
+    cy_socket_sockaddr_t rejected_addr;
+    uint32_t rejected_addr_len = sizeof(rejected_addr);
+    uint32_t clients = 0U;
+
+    session = tcp_session_alloc();
+    if((NULL == session) && tcp_session_evict_lru())
+    {
+        session = tcp_session_alloc();
+    }
+
+    if(NULL == session)
+    {
+        /* Accept the connection only to remove it from the listen backlog. */
+        result = cy_socket_accept(socket_handle, &rejected_addr, &rejected_addr_len,
+                                  &rejected_handle);
+        if(CY_RSLT_SUCCESS == result)
+        {
+            cy_socket_disconnect(rejected_handle, RESET_VAL);
+            cy_socket_delete(rejected_handle);
+        }
+        server_stats_add(SERVER_STATS_SESSIONS_REJECTED, 1U);
+        APP_LOG_WARN("Session table full (%u clients). Incoming connection rejected\n",
+                     TCP_SERVER_MAX_CLIENTS);
+        return result;
+    }
+
+    /* Accept new incoming connection from a TCP client and
+     * perform TLS handshake. */
+    handshake_ticks = xTaskGetTickCount();
+    trace_point(TRACE_EVENT_ACCEPT_START, (uint32_t)(session - tcp_sessions), 0U);
+    result = cy_socket_accept(socket_handle, &session->peer_addr, &session->peer_addr_len,
+                              &session->socket_handle);
+    trace_point(TRACE_EVENT_ACCEPT_DONE, (uint32_t)(session - tcp_sessions),
+                (CY_RSLT_SUCCESS == result) ? 1U : 0U);
+    handshake_ticks = xTaskGetTickCount() - handshake_ticks;
+    if(CY_RSLT_SUCCESS == result)
+    {
+        if(CY_SOCKET_IP_VER_V6 == session->peer_addr.ip_address.version)
+        {
+            ip6addr_ntoa_r((const ip6_addr_t*)&session->peer_addr.ip_address.ip.v6,
+                           session->peer_name, sizeof(session->peer_name));
+        }
+        else
+        {
+            ip4addr_ntoa_r((const ip4_addr_t*)&session->peer_addr.ip_address.ip.v4,
+                           session->peer_name, sizeof(session->peer_name));
+        }
+
+        /* Route the callbacks of the client socket straight to its session. */
+        result = tcp_session_register_callbacks(session);
+    }
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    if(CY_RSLT_SUCCESS == result)
+    {
+        session->state = TCP_SESSION_STATE_CONNECTED;
+        session->last_activity = xTaskGetTickCount();
+        /* Data that arrived during the handshake raised the receive callback
+         * before the session was open, so the RX task reads it once anyway. */
+        session->rx_ready = true;
+        session->core = ipc_offload_attach();
+        clients = app_state_client_connected();
+    }
+    else if(NULL != session->socket_handle)
+    {
+        tcp_session_release(session);
+    }
+    else
+    {
+        session->state = TCP_SESSION_STATE_FREE;
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    if(CY_RSLT_SUCCESS == result )
+    {
+        tcp_server_signal(SERVER_EVENT_SOCKET_READABLE);
+
+        server_stats_add(SERVER_STATS_ACCEPTS, 1U);
+        server_stats_record_handshake((uint32_t)(handshake_ticks * portTICK_PERIOD_MS));
+
+        APP_LOG_INFO("Incoming TCP connection accepted from %s\n"
+                     "TLS Handshake successful and communication secured! (%"PRIu32" ms)\n",
+                     session->peer_name, (uint32_t)(handshake_ticks * portTICK_PERIOD_MS));
+        APP_LOG_INFO("Connected TCP clients: %"PRIu32" of %u\n"
+                     "Press the user button to send LED ON/OFF command to the TCP client\n",
+                     clients, TCP_SERVER_MAX_CLIENTS);
+    }
+    else
+    {
+        server_stats_add(SERVER_STATS_HANDSHAKE_FAILURES, 1U);
+        APP_LOG_ERROR("Failed to accept incoming client connection. Error: %"PRIu32"\n"
+                      "===============================================================\n"
+                      "Listening for incoming TCP client connection on Port: %d\n",
+                      result, TCP_SERVER_PORT);
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,752 @@
+/******************************************************************************
+* File Name:   tcp_protocol.c
+*
+* Description: This file contains the application protocols served on the secure
+* TCP server port: their frame queues and tasks, and the handlers of the
+* control and telemetry frames.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#include <queue.h>
+
+/* Standard C header file */
+#include <string.h>
+/* To use the portable formatting macros */
+#include <inttypes.h>
+
+/* Secure TCP server header file */
+#include "secure_tcp_server.h"
+
+/* Session table header file */
+#include "tcp_session.h"
+
+/* Application protocol header file */
+#include "tcp_protocol.h"
+
+/* Streaming header file */
+#include "tcp_stream.h"
+
+/* Runtime performance counters header file */
+#include "server_stats.h"
+
+/* Deferred logger header file */
+#include "app_log.h"
+
+/* CM55 offload pipeline header file */
+#include "ipc_offload.h"
+
+/* Shared application state header file */
+#include "app_state.h"
+
+/* Network memory profile header file */
+#include "net_profile.h"
+
+/* Trace ring header file */
+#include "trace_ring.h"
+
+/* Power policy header file */
+#include "power_policy.h"
+
+_Static_assert((TCP_FRAME_HEADER_LEN + SERVER_STATS_SNAPSHOT_MAX_LEN) <= TCP_SESSION_TX_BATCH_SIZE,
+               "A STATS_RSP frame must fit in a transmit batch");
+_Static_assert(TCP_FRAME_MAX_PAYLOAD_LEN <= IPC_OFFLOAD_MAX_DATA_LEN,
+               "A DATA frame must fit in an offload descriptor");
+_Static_assert((TRACE_RING_SIZE <= 0xFFFFU) && (TCP_FRAME_TRACE_RECORDS_MAX <= 0xFFU),
+               "The record indexes and counts of a TRACE_RSP frame are 16 and 8 bits wide");
+_Static_assert(TCP_FRAME_POWER_REPORT_LEN == (1U + (20U * POWER_POLICY_COUNT)),
+               "A POWER_REPORT frame carries the measurements of every policy");
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Handler of one decoded frame type. The payload points into the session
+ * receive buffer and is only valid for the duration of the call. */
+typedef void (*tcp_frame_handler_t)(tcp_session_t *session, const uint8_t *payload,
+                                    uint32_t length);
+
+/* Frame queued to the task of a protocol. The payload follows it in the
+ * queue item. */
+typedef struct
+{
+    tcp_session_t *session;
+    cy_socket_t socket_handle;
+    uint32_t length;
+    uint8_t type;
+} tcp_protocol_frame_t;
+
+/* Application protocol. stalled has a bit set for every session whose frames
+ * wait for room in the queue; it is updated in critical sections, as the
+ * RX task and the protocol task both use it. */
+typedef struct
+{
+    const char *name;
+    const tcp_frame_handler_t *handlers;
+    uint32_t queue_depth;
+    UBaseType_t priority;
+    uint32_t max_payload;
+    const char *task_name;
+    QueueHandle_t queue;
+    uint32_t stalled;
+} tcp_protocol_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+
+static void tcp_protocol_task(void *arg);
+static void tcp_led_ack_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                      uint32_t length);
+static void tcp_stats_req_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                        uint32_t length);
+static void tcp_trace_req_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                        uint32_t length);
+static void tcp_trace_rsp_write_header(uint8_t *frame, uint32_t total, uint32_t first,
+                                       uint32_t count, uint8_t flags);
+static void tcp_power_policy_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                           uint32_t length);
+static void tcp_data_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                   uint32_t length);
+static void tcp_data_frame_complete(void *arg, void *handle,
+                                    const ipc_offload_completion_t *completion);
+
+/* Frame handlers of the control protocol, indexed by frame type. It also
+ * takes DATA frames, for clients that select no protocol. */
+static const tcp_frame_handler_t tcp_control_handlers[TCP_FRAME_TYPE_COUNT] =
+{
+    [TCP_FRAME_TYPE_LED_ACK] = tcp_led_ack_frame_handler,
+    [TCP_FRAME_TYPE_STATS_REQ] = tcp_stats_req_frame_handler,
+    [TCP_FRAME_TYPE_DATA] = tcp_data_frame_handler,
+    [TCP_FRAME_TYPE_TRACE_REQ] = tcp_trace_req_frame_handler,
+    [TCP_FRAME_TYPE_POWER_POLICY] = tcp_power_policy_frame_handler
+};
+
+/* Frame handlers of the telemetry protocol, indexed by frame type. */
+static const tcp_frame_handler_t tcp_telemetry_handlers[TCP_FRAME_TYPE_COUNT] =
+{
+    [TCP_FRAME_TYPE_STATS_REQ] = tcp_stats_req_frame_handler,
+    [TCP_FRAME_TYPE_DATA] = tcp_data_frame_handler,
+    [TCP_FRAME_TYPE_STREAM_START] = tcp_stream_start_frame_handler,
+    [TCP_FRAME_TYPE_STREAM_CREDIT] = tcp_stream_credit_frame_handler,
+    [TCP_FRAME_TYPE_STREAM_STOP] = tcp_stream_stop_frame_handler
+};
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Application protocols served on TCP_SERVER_PORT. */
+static tcp_protocol_t tcp_protocols[TCP_PROTOCOL_COUNT] =
+{
+    [TCP_PROTOCOL_CONTROL] =
+    {
+        .name = TCP_PROTOCOL_CONTROL_NAME,
+        .handlers = tcp_control_handlers,
+        .queue_depth = TCP_PROTOCOL_CONTROL_QUEUE_DEPTH,
+        .priority = TCP_PROTOCOL_CONTROL_PRIORITY,
+        .max_payload = TCP_PROTOCOL_CONTROL_MAX_PAYLOAD_LEN,
+        .task_name = "Control task"
+    },
+    [TCP_PROTOCOL_TELEMETRY] =
+    {
+        .name = TCP_PROTOCOL_TELEMETRY_NAME,
+        .handlers = tcp_telemetry_handlers,
+        .queue_depth = TCP_PROTOCOL_TELEMETRY_QUEUE_DEPTH,
+        .priority = TCP_PROTOCOL_TELEMETRY_PRIORITY,
+        .max_payload = TCP_PROTOCOL_TELEMETRY_MAX_PAYLOAD_LEN,
+        .task_name = "Telemetry task"
+    }
+};
+
+/* Queue item the RX task assembles a frame in before queuing it. The
+ * largest payload of any protocol fits. */
+static uint8_t tcp_protocol_item[sizeof(tcp_protocol_frame_t) + TCP_FRAME_MAX_PAYLOAD_LEN];
+
+_Static_assert((TCP_PROTOCOL_CONTROL_MAX_PAYLOAD_LEN <= TCP_FRAME_MAX_PAYLOAD_LEN) &&
+               (TCP_PROTOCOL_TELEMETRY_MAX_PAYLOAD_LEN <= TCP_FRAME_MAX_PAYLOAD_LEN),
+               "Protocol payloads must fit a frame");
+
+/*******************************************************************************
+ * Function Name: tcp_protocols_init
+ *******************************************************************************
+ * Summary:
+ *  Creates the frame queue and the task of every application protocol that
+ *  does not handle its frames on the RX task.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_result result: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_protocols_init(void)
+{
+    tcp_protocol_t *protocol;
+    uint32_t index;
+
+    for(index = 0; index < TCP_PROTOCOL_COUNT; index++)
+    {
+        protocol = &tcp_protocols[index];
+        if(0U == protocol->queue_depth)
+        {
+            continue;
+        }
+
+        protocol->queue = xQueueCreate(protocol->queue_depth,
+                                       sizeof(tcp_protocol_frame_t) + protocol->max_payload);
+        if(NULL == protocol->queue)
+        {
+            return CY_RSLT_TYPE_ERROR;
+        }
+
+        if(pdPASS != xTaskCreate(tcp_protocol_task, protocol->task_name,
+                                 TCP_PROTOCOL_TASK_STACK_SIZE, protocol,
+                                 protocol->priority, NULL))
+        {
+            return CY_RSLT_TYPE_ERROR;
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_protocol_task
+ *******************************************************************************
+ * Summary:
+ *  Task of an application protocol. Hands every queued frame to the handler
+ *  of its type if the client that sent it is still connected, then lets the
+ *  RX task resume reading from the sessions that waited for room in the
+ *  queue.
+ *
+ * Parameters:
+ *  void *arg: Protocol served by the task
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_protocol_task(void *arg)
+{
+    tcp_protocol_t *protocol = (tcp_protocol_t *)arg;
+    uint8_t item[sizeof(tcp_protocol_frame_t) + TCP_FRAME_MAX_PAYLOAD_LEN];
+    tcp_protocol_frame_t frame;
+    uint32_t stalled;
+    uint32_t index;
+    bool open;
+
+    while(true)
+    {
+        (void)xQueueReceive(protocol->queue, item, portMAX_DELAY);
+        memcpy(&frame, item, sizeof(frame));
+
+        /* Keep the session on the same client while its handler runs. */
+        xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+        open = tcp_session_is_open(frame.session, frame.socket_handle);
+        if(open)
+        {
+            frame.session->users++;
+        }
+        xSemaphoreGive(tcp_sessions_mutex);
+
+        if(open)
+        {
+            protocol->handlers[frame.type](frame.session, &item[sizeof(frame)], frame.length);
+
+            xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+            tcp_session_put(frame.session);
+            xSemaphoreGive(tcp_sessions_mutex);
+        }
+
+        taskENTER_CRITICAL();
+        stalled = protocol->stalled;
+        protocol->stalled = 0U;
+        taskEXIT_CRITICAL();
+
+        if(0U != stalled)
+        {
+            xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+            for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+            {
+                if(0U != (stalled & (1UL << index)))
+                {
+                    tcp_sessions[index].rx_ready = true;
+                }
+            }
+            xSemaphoreGive(tcp_sessions_mutex);
+            tcp_server_signal(SERVER_EVENT_SOCKET_READABLE);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_handle_frame
+ *******************************************************************************
+ * Summary:
+ *  Hands a frame to the handler of its type in the protocol of the session,
+ *  either right away or through the queue of the protocol. Frames the
+ *  protocol has no handler for, or whose payload is too long for it, are
+ *  ignored.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  uint8_t type: Frame type
+ *  const uint8_t *payload: Frame payload
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  bool: false if the queue of the protocol is full and the frame must be
+ *  handed over again later.
+ *
+ *******************************************************************************/
+bool tcp_session_handle_frame(tcp_session_t *session, uint8_t type,
+                              const uint8_t *payload, uint32_t length)
+{
+    tcp_protocol_t *protocol = &tcp_protocols[session->protocol];
+    tcp_protocol_frame_t frame;
+    uint32_t bit = 1UL << (uint32_t)(session - tcp_sessions);
+
+    if((type >= TCP_FRAME_TYPE_COUNT) || (NULL == protocol->handlers[type]) ||
+       (length > protocol->max_payload))
+    {
+        APP_LOG_DEBUG("Ignoring frame of type 0x%02x on protocol %s\n", type, protocol->name);
+        return true;
+    }
+
+    if(0U == protocol->queue_depth)
+    {
+        protocol->handlers[type](session, payload, length);
+        return true;
+    }
+
+    frame.session = session;
+    frame.socket_handle = session->socket_handle;
+    frame.length = length;
+    frame.type = type;
+    memcpy(tcp_protocol_item, &frame, sizeof(frame));
+    memcpy(&tcp_protocol_item[sizeof(frame)], payload, length);
+
+    if(pdTRUE == xQueueSend(protocol->queue, tcp_protocol_item, 0U))
+    {
+        return true;
+    }
+
+    /* Ask the protocol task to wake this session once it takes a frame, and
+     * try again in case it emptied the queue before seeing the request. */
+    taskENTER_CRITICAL();
+    protocol->stalled |= bit;
+    taskEXIT_CRITICAL();
+
+    return (pdTRUE == xQueueSend(protocol->queue, tcp_protocol_item, 0U));
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_select_protocol
+ *******************************************************************************
+ * Summary:
+ *  Handles a PROTOCOL_SELECT frame, whose payload is the name of the protocol
+ *  the client speaks from then on, and answers with a PROTOCOL_ACK frame. An
+ *  unknown name leaves the protocol of the session unchanged.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Frame payload
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_session_select_protocol(tcp_session_t *session, const uint8_t *payload,
+                                 uint32_t length)
+{
+    uint8_t ack = TCP_PROTOCOL_UNKNOWN;
+    uint32_t index;
+
+    for(index = 0; index < TCP_PROTOCOL_COUNT; index++)
+    {
+        if((strlen(tcp_protocols[index].name) == length) &&
+           (0 == memcmp(tcp_protocols[index].name, payload, length)))
+        {
+            session->protocol = (tcp_protocol_id_t)index;
+            ack = (uint8_t)index;
+            break;
+        }
+    }
+
+    if(TCP_PROTOCOL_UNKNOWN == ack)
+    {
+        APP_LOG_WARN("TCP client %u selected an unknown protocol\n",
+                     (unsigned int)(session - tcp_sessions));
+    }
+    else
+    {
+        APP_LOG_INFO("TCP client %u selected protocol %s\n",
+                     (unsigned int)(session - tcp_sessions), tcp_protocols[index].name);
+    }
+
+    (void)tcp_session_queue_frame(session, session->socket_handle, TCP_FRAME_TYPE_PROTOCOL_ACK,
+                                  &ack, TCP_FRAME_PROTOCOL_ACK_LEN);
+}
+
+/*******************************************************************************
+ * Function Name: tcp_led_ack_frame_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles the acknowledgement of an LED ON/OFF command. The payload echoes
+ *  the command applied by the TCP client.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Frame payload
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_led_ack_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                      uint32_t length)
+{
+    if(TCP_LED_CMD_LEN != length)
+    {
+        return;
+    }
+
+    /* Set the LED state based on the acknowledgement received from the TCP client. */
+    app_state_set_led(LED_ON_CMD == payload[0]);
+
+    APP_LOG_INFO("\r\nAcknowledgement from TCP client %u: LED %s\n"
+                 "===============================================================\n"
+                 "Press the user button to send LED ON/OFF command to the TCP client\n",
+                 (unsigned int)(session - tcp_sessions),
+                 (LED_ON_CMD == payload[0]) ? "ON" : "OFF");
+}
+
+/*******************************************************************************
+ * Function Name: tcp_data_frame_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles an application data frame. Its processing, computing the CRC-32
+ *  echoed in the DATA_ACK frame, is offloaded to CM55 when the session is on
+ *  CM55 and CM55 can take it.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Frame payload
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_data_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                   uint32_t length)
+{
+    (void)ipc_offload_submit(session->core, IPC_OFFLOAD_OP_CRC32, payload, length,
+                             tcp_data_frame_complete, session, session->socket_handle);
+}
+
+/*******************************************************************************
+ * Function Name: tcp_data_frame_complete
+ *******************************************************************************
+ * Summary:
+ *  Completion callback of a data frame. Queues the DATA_ACK frame if the
+ *  client that sent the data is still connected. The batch is flushed by the
+ *  TX task once its deadline comes.
+ *
+ * Parameters:
+ *  void *arg: Session the frame was received on
+ *  void *handle: Client socket the frame was received on
+ *  const ipc_offload_completion_t *completion: Outcome of the processing
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_data_frame_complete(void *arg, void *handle,
+                                    const ipc_offload_completion_t *completion)
+{
+    tcp_session_t *session = (tcp_session_t *)arg;
+    uint8_t ack[TCP_FRAME_DATA_ACK_LEN];
+
+    if(IPC_OFFLOAD_STATUS_OK != completion->status)
+    {
+        APP_LOG_WARN("Processing of a data frame failed. Status: %"PRIu32"\n",
+                     completion->status);
+        return;
+    }
+
+    ack[0] = (uint8_t)(completion->result >> 24);
+    ack[1] = (uint8_t)(completion->result >> 16);
+    ack[2] = (uint8_t)(completion->result >> 8);
+    ack[3] = (uint8_t)completion->result;
+
+    (void)tcp_session_queue_frame(session, (cy_socket_t)handle, TCP_FRAME_TYPE_DATA_ACK,
+                                  ack, sizeof(ack));
+}
+
+/*******************************************************************************
+ * Function Name: tcp_stats_req_frame_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles a statistics request by sending a snapshot of the runtime
+ *  performance counters back in a STATS_RSP frame. The response is flushed
+ *  right away rather than waiting for the batch deadline.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Frame payload (unused)
+ *  uint32_t length: Payload length (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_stats_req_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                        uint32_t length)
+{
+    uint8_t *snapshot;
+
+    CY_UNUSED_PARAMETER(payload);
+    CY_UNUSED_PARAMETER(length);
+
+    net_profile_track();
+
+    /* The snapshot is written straight into the transmit batch. */
+    snapshot = tcp_session_reserve_frame(session, NULL, SERVER_STATS_SNAPSHOT_MAX_LEN);
+    if(NULL != snapshot)
+    {
+        tcp_session_commit_frame(session, TCP_FRAME_TYPE_STATS_RSP,
+                                 server_stats_snapshot(snapshot,
+                                                       SERVER_STATS_SNAPSHOT_MAX_LEN));
+        tcp_session_flush(session);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_trace_req_frame_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles a trace request by sending the records of the trace ring in
+ *  TRACE_RSP frames, each written straight into the transmit batch and
+ *  flushed right away. The ring is frozen while it is read out, then cleared
+ *  once every record was queued, so that the next dump covers what happened
+ *  since this one. A dump cut short ends with a TRUNCATED frame and leaves the
+ *  ring frozen, so that the next request sends the same records again.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Frame payload (unused)
+ *  uint32_t length: Payload length (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_trace_req_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                        uint32_t length)
+{
+    trace_record_t records[TCP_FRAME_TRACE_RECORDS_MAX];
+    uint8_t *frame;
+    uint8_t *record;
+    uint32_t total;
+    uint32_t first = 0U;
+    uint32_t count;
+    uint32_t index;
+    bool truncated = false;
+
+    CY_UNUSED_PARAMETER(payload);
+    CY_UNUSED_PARAMETER(length);
+
+    total = trace_ring_freeze();
+
+    do
+    {
+        count = trace_ring_read(first, records, TCP_FRAME_TRACE_RECORDS_MAX);
+        frame = tcp_session_reserve_frame(session, NULL, TCP_FRAME_TRACE_RSP_HEADER_LEN +
+                                          (count * TCP_FRAME_TRACE_RECORD_LEN));
+        if(NULL == frame)
+        {
+            truncated = true;
+            break;
+        }
+
+        tcp_trace_rsp_write_header(frame, total, first, count, 0U);
+
+        record = &frame[TCP_FRAME_TRACE_RSP_HEADER_LEN];
+        for(index = 0U; index < count; index++)
+        {
+            record[0] = (uint8_t)(records[index].cycles >> 24);
+            record[1] = (uint8_t)(records[index].cycles >> 16);
+            record[2] = (uint8_t)(records[index].cycles >> 8);
+            record[3] = (uint8_t)records[index].cycles;
+            record[4] = records[index].event;
+            record[5] = records[index].session;
+            record[6] = (uint8_t)(records[index].value >> 8);
+            record[7] = (uint8_t)records[index].value;
+            record += TCP_FRAME_TRACE_RECORD_LEN;
+        }
+
+        tcp_session_commit_frame(session, TCP_FRAME_TYPE_TRACE_RSP,
+                                 TCP_FRAME_TRACE_RSP_HEADER_LEN +
+                                 (count * TCP_FRAME_TRACE_RECORD_LEN));
+        tcp_session_flush(session);
+        first += count;
+    } while(first < total);
+
+    if(!truncated)
+    {
+        trace_ring_resume();
+        return;
+    }
+
+    /* Tell the client where the dump stopped. The header alone may still fit
+     * behind the frames queued. */
+    APP_LOG_WARN("Trace dump truncated after %"PRIu32" of %"PRIu32" records\n", first, total);
+    frame = tcp_session_reserve_frame(session, NULL, TCP_FRAME_TRACE_RSP_HEADER_LEN);
+    if(NULL != frame)
+    {
+        tcp_trace_rsp_write_header(frame, total, first, 0U, TCP_FRAME_TRACE_RSP_TRUNCATED);
+        tcp_session_commit_frame(session, TCP_FRAME_TYPE_TRACE_RSP,
+                                 TCP_FRAME_TRACE_RSP_HEADER_LEN);
+        tcp_session_flush(session);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_trace_rsp_write_header
+ *******************************************************************************
+ * Summary:
+ *  Writes the header of a TRACE_RSP frame.
+ *
+ * Parameters:
+ *  uint8_t *frame: Payload of the frame
+ *  uint32_t total: Number of records of the dump
+ *  uint32_t first: Index of the first record of the frame
+ *  uint32_t count: Number of records of the frame
+ *  uint8_t flags: TCP_FRAME_TRACE_RSP_* flags of the frame
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_trace_rsp_write_header(uint8_t *frame, uint32_t total, uint32_t first,
+                                       uint32_t count, uint8_t flags)
+{
+    frame[0] = (uint8_t)(SystemCoreClock >> 24);
+    frame[1] = (uint8_t)(SystemCoreClock >> 16);
+    frame[2] = (uint8_t)(SystemCoreClock >> 8);
+    frame[3] = (uint8_t)SystemCoreClock;
+    frame[4] = (uint8_t)(total >> 8);
+    frame[5] = (uint8_t)total;
+    frame[6] = (uint8_t)(first >> 8);
+    frame[7] = (uint8_t)first;
+    frame[8] = (uint8_t)count;
+    frame[9] = flags;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_power_policy_frame_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles a POWER_POLICY frame: selects the power policy it carries, if any,
+ *  and answers with the measurements of every policy in a POWER_REPORT frame.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Policy to select, or nothing to only report
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_power_policy_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                           uint32_t length)
+{
+    power_policy_stats_t stats[POWER_POLICY_COUNT];
+    uint32_t values[5];
+    uint8_t *report;
+    uint32_t policy;
+    uint32_t value;
+
+    if((TCP_FRAME_POWER_POLICY_LEN == length) && (payload[0] < (uint8_t)POWER_POLICY_COUNT))
+    {
+        power_policy_set((power_policy_t)payload[0]);
+        APP_LOG_INFO("Power policy set to %s\n",
+                     (POWER_POLICY_LOW_LATENCY == payload[0]) ? "low latency" : "eco");
+    }
+
+    power_policy_report(stats);
+
+    report = tcp_session_reserve_frame(session, NULL, TCP_FRAME_POWER_REPORT_LEN);
+    if(NULL == report)
+    {
+        return;
+    }
+
+    report[0] = (uint8_t)power_policy_get();
+    for(policy = 0U; policy < (uint32_t)POWER_POLICY_COUNT; policy++)
+    {
+        values[0] = stats[policy].responses;
+        values[1] = stats[policy].latency_mean_us;
+        values[2] = stats[policy].latency_max_us;
+        values[3] = stats[policy].deep_sleeps;
+        values[4] = stats[policy].deep_sleeps_held_off;
+        for(value = 0U; value < 5U; value++)
+        {
+            report[1U + (policy * 20U) + (value * 4U)] = (uint8_t)(values[value] >> 24);
+            report[2U + (policy * 20U) + (value * 4U)] = (uint8_t)(values[value] >> 16);
+            report[3U + (policy * 20U) + (value * 4U)] = (uint8_t)(values[value] >> 8);
+            report[4U + (policy * 20U) + (value * 4U)] = (uint8_t)values[value];
+        }
+    }
+
+    tcp_session_commit_frame(session, TCP_FRAME_TYPE_POWER_REPORT, TCP_FRAME_POWER_REPORT_LEN);
+    tcp_session_flush(session);
+}
+
+/* [] END OF FILE */
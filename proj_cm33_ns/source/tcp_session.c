@@ -0,0 +1,1171 @@
+/******************************************************************************
+* File Name:   tcp_session.c
+*
+* Description: This file contains the secure TCP client session table: slot
+* allocation and release, the transmit batches, the receive path and the
+* eviction of idle sessions.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+
+/* Standard C header file */
+#include <string.h>
+/* To use the portable formatting macros */
+#include <inttypes.h>
+
+/* Secure socket header file. */
+#include "cy_secure_sockets.h"
+
+/* Secure TCP server header file */
+#include "secure_tcp_server.h"
+
+/* Session table header file */
+#include "tcp_session.h"
+
+/* Application protocol header file */
+#include "tcp_protocol.h"
+
+/* Streaming header file */
+#include "tcp_stream.h"
+
+/* Runtime performance counters header file */
+#include "server_stats.h"
+
+/* Deferred logger header file */
+#include "app_log.h"
+
+/* Shared application state header file */
+#include "app_state.h"
+
+/* Trace ring header file */
+#include "trace_ring.h"
+
+/* Power policy header file */
+#include "power_policy.h"
+
+_Static_assert(TCP_SERVER_MAX_CLIENTS <= 32U,
+               "The sessions due for a flush are collected in a 32-bit mask");
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+
+static tcp_session_t *tcp_session_find(cy_socket_t socket_handle);
+static void tcp_session_teardown(tcp_session_t *session);
+static void tcp_session_receive(tcp_session_t *session);
+static bool tcp_session_dispatch_frames(tcp_session_t *session);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Secure TCP client session table and the mutex protecting it. */
+tcp_session_t tcp_sessions[TCP_SERVER_MAX_CLIENTS];
+SemaphoreHandle_t tcp_sessions_mutex;
+
+/*******************************************************************************
+ * Function Name: tcp_sessions_init
+ *******************************************************************************
+ * Summary:
+ *  Creates the mutex protecting the session table. It is shared between the
+ *  server tasks and the secure socket callbacks.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_result result: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_sessions_init(void)
+{
+    tcp_sessions_mutex = xSemaphoreCreateMutex();
+
+    return (NULL == tcp_sessions_mutex) ? CY_RSLT_TYPE_ERROR : CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_alloc
+ *******************************************************************************
+ * Summary:
+ *  Reserves a free slot of the session table for a connection that is about
+ *  to be accepted.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  tcp_session_t *: Reserved session slot, or NULL if the table is full.
+ *
+ *******************************************************************************/
+tcp_session_t *tcp_session_alloc(void)
+{
+    tcp_session_t *session = NULL;
+    uint32_t index;
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        if(TCP_SESSION_STATE_FREE == tcp_sessions[index].state)
+        {
+            session = &tcp_sessions[index];
+            memset(session, 0, sizeof(tcp_session_t));
+            session->state = TCP_SESSION_STATE_ACCEPTING;
+            session->peer_addr_len = sizeof(session->peer_addr);
+            break;
+        }
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    return session;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_find
+ *******************************************************************************
+ * Summary:
+ *  Looks up the session owning a client socket. Only used for callbacks that
+ *  fire before the per-session callback argument has been registered.
+ *
+ * Parameters:
+ *  cy_socket_t socket_handle: Connection handle for the TCP client socket
+ *
+ * Return:
+ *  tcp_session_t *: Session owning the socket, or NULL if there is none.
+ *
+ *******************************************************************************/
+static tcp_session_t *tcp_session_find(cy_socket_t socket_handle)
+{
+    uint32_t index;
+
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        if((TCP_SESSION_STATE_FREE != tcp_sessions[index].state) &&
+           (socket_handle == tcp_sessions[index].socket_handle))
+        {
+            return &tcp_sessions[index];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_is_open
+ *******************************************************************************
+ * Summary:
+ *  Checks that a session is connected on a given client socket. Must be called
+ *  with the session table mutex held.
+ *
+ * Parameters:
+ *  const tcp_session_t *session: Session to check
+ *  cy_socket_t socket_handle: Expected client socket, or NULL for any
+ *
+ * Return:
+ *  bool: true if the session is connected on the socket.
+ *
+ *******************************************************************************/
+bool tcp_session_is_open(const tcp_session_t *session, cy_socket_t socket_handle)
+{
+    return (TCP_SESSION_STATE_CONNECTED == session->state) &&
+           ((NULL == socket_handle) || (socket_handle == session->socket_handle));
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_release
+ *******************************************************************************
+ * Summary:
+ *  Disconnects and deletes the client socket of a session and returns the slot
+ *  to the session table. If a task still uses the socket, the session only
+ *  moves to the CLOSING state and that task completes the release. Must be
+ *  called with the session table mutex held.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session to release
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_session_release(tcp_session_t *session)
+{
+    if(TCP_SESSION_STATE_FREE == session->state)
+    {
+        return;
+    }
+
+    if(TCP_SESSION_STATE_CONNECTED == session->state)
+    {
+        (void)app_state_client_disconnected();
+        ipc_offload_detach(session->core);
+    }
+
+    if(0U != session->users)
+    {
+        session->state = TCP_SESSION_STATE_CLOSING;
+        return;
+    }
+
+    tcp_session_teardown(session);
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_put
+ *******************************************************************************
+ * Summary:
+ *  Drops the reference a task took on a session to use its socket outside the
+ *  session table mutex, and completes a release that was deferred meanwhile.
+ *  Must be called with the session table mutex held.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the reference was taken on
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_session_put(tcp_session_t *session)
+{
+    session->users--;
+    if((0U == session->users) && (TCP_SESSION_STATE_CLOSING == session->state))
+    {
+        tcp_session_teardown(session);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_teardown
+ *******************************************************************************
+ * Summary:
+ *  Disconnects and deletes the client socket of a session nobody uses anymore
+ *  and frees the slot. Must be called with the session table mutex held.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session to tear down
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_session_teardown(tcp_session_t *session)
+{
+    /* Disconnect the socket. */
+    cy_socket_disconnect(session->socket_handle, RESET_VAL);
+    /* Delete the socket. */
+    cy_socket_delete(session->socket_handle);
+
+    session->socket_handle = NULL;
+    session->state = TCP_SESSION_STATE_FREE;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_register_callbacks
+ *******************************************************************************
+ * Summary:
+ *  Registers the receive and disconnect callbacks on an accepted client socket
+ *  with the session slot as the callback argument, and sets the receive
+ *  timeout used while draining the socket.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session owning the accepted client socket
+ *
+ * Return:
+ *  cy_result result: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_session_register_callbacks(tcp_session_t *session)
+{
+    cy_rslt_t result;
+    cy_socket_opt_callback_t tcp_receive_option;
+    cy_socket_opt_callback_t tcp_disconnect_option;
+    uint32_t drain_timeout = TCP_SESSION_DRAIN_TIMEOUT_MS;
+#if (TCP_SESSION_KEEPALIVE_ENABLE)
+    uint32_t keepalive_enable = 1U;
+    uint32_t keepalive_idle = TCP_SESSION_KEEPALIVE_IDLE_MS;
+    uint32_t keepalive_interval = TCP_SESSION_KEEPALIVE_INTERVAL_MS;
+    uint32_t keepalive_count = TCP_SESSION_KEEPALIVE_COUNT;
+#endif
+
+    /* Bound the wait of the last read of the receive drain loop. */
+    result = cy_socket_setsockopt(session->socket_handle, CY_SOCKET_SOL_SOCKET,
+                                  CY_SOCKET_SO_RCVTIMEO, &drain_timeout,
+                                  sizeof(drain_timeout));
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+#if (TCP_SESSION_KEEPALIVE_ENABLE)
+    /* Probe the peer while the connection is quiet. A failure is not fatal:
+     * the idle timeout still reclaims the slot. */
+    if((CY_RSLT_SUCCESS != cy_socket_setsockopt(session->socket_handle, CY_SOCKET_SOL_TCP,
+                                                CY_SOCKET_SO_TCP_KEEPALIVE_IDLE_TIME,
+                                                &keepalive_idle, sizeof(keepalive_idle))) ||
+       (CY_RSLT_SUCCESS != cy_socket_setsockopt(session->socket_handle, CY_SOCKET_SOL_TCP,
+                                                CY_SOCKET_SO_TCP_KEEPALIVE_INTERVAL,
+                                                &keepalive_interval, sizeof(keepalive_interval))) ||
+       (CY_RSLT_SUCCESS != cy_socket_setsockopt(session->socket_handle, CY_SOCKET_SOL_TCP,
+                                                CY_SOCKET_SO_TCP_KEEPALIVE_COUNT,
+                                                &keepalive_count, sizeof(keepalive_count))) ||
+       (CY_RSLT_SUCCESS != cy_socket_setsockopt(session->socket_handle, CY_SOCKET_SOL_TCP,
+                                                CY_SOCKET_SO_TCP_KEEPALIVE_ENABLE,
+                                                &keepalive_enable, sizeof(keepalive_enable))))
+    {
+        APP_LOG_WARN("Failed to enable TCP keepalive for TCP client %s\n", session->peer_name);
+    }
+#endif
+
+    tcp_receive_option.callback = tcp_receive_msg_handler;
+    tcp_receive_option.arg = session;
+
+    result = cy_socket_setsockopt(session->socket_handle, CY_SOCKET_SOL_SOCKET,
+                                  CY_SOCKET_SO_RECEIVE_CALLBACK,
+                                  &tcp_receive_option, sizeof(cy_socket_opt_callback_t));
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    tcp_disconnect_option.callback = tcp_disconnection_handler;
+    tcp_disconnect_option.arg = session;
+
+    return cy_socket_setsockopt(session->socket_handle, CY_SOCKET_SOL_SOCKET,
+                                CY_SOCKET_SO_DISCONNECT_CALLBACK,
+                                &tcp_disconnect_option, sizeof(cy_socket_opt_callback_t));
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_reserve_frame
+ *******************************************************************************
+ * Summary:
+ *  Reserves room for a frame in the transmit batch of a session, so that the
+ *  caller can write the payload straight into the batch instead of copying
+ *  it in. The batch is flushed first when the frame does not fit behind the
+ *  frames already queued. Must be called without the session table mutex
+ *  held. On success, the mutex is held until tcp_session_commit_frame() is
+ *  called, so the payload should be written without blocking.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session to send the frame to
+ *  cy_socket_t socket_handle: Client socket the frame is meant for, or NULL
+ *   for whichever client is connected on the session
+ *  uint32_t max_length: Largest payload the caller may write
+ *
+ * Return:
+ *  uint8_t *: Where to write the payload, or NULL if no room was reserved.
+ *
+ *******************************************************************************/
+uint8_t *tcp_session_reserve_frame(tcp_session_t *session, cy_socket_t socket_handle,
+                                   uint32_t max_length)
+{
+    uint32_t frame_len = TCP_FRAME_HEADER_LEN + max_length;
+    uint32_t attempt;
+
+    if(frame_len > TCP_SESSION_TX_BATCH_SIZE)
+    {
+        return NULL;
+    }
+
+    /* A frame that does not fit behind the queued ones is retried once after
+     * the batch is flushed. */
+    for(attempt = 0U; attempt < 2U; attempt++)
+    {
+        xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+        if(!tcp_session_is_open(session, socket_handle))
+        {
+            break;
+        }
+
+        if((session->tx_len + frame_len) <= TCP_SESSION_TX_BATCH_SIZE)
+        {
+            return &session->tx_buffers[session->tx_fill][session->tx_len +
+                                                          TCP_FRAME_HEADER_LEN];
+        }
+
+        if(session->tx_busy)
+        {
+            /* Both buffers are taken: the previous batch is still being sent
+             * and the next one is full. Leave the full batch to the sending
+             * task and drop the frame; the stats snapshot counts the drops. */
+            session->tx_flush_requested = true;
+            server_stats_add(SERVER_STATS_TX_DROPS, 1U);
+            break;
+        }
+        xSemaphoreGive(tcp_sessions_mutex);
+
+        tcp_session_flush(session);
+    }
+
+    if(attempt < 2U)
+    {
+        xSemaphoreGive(tcp_sessions_mutex);
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_commit_frame
+ *******************************************************************************
+ * Summary:
+ *  Completes a frame reserved with tcp_session_reserve_frame(): writes its
+ *  header, appends it to the batch and releases the session table mutex.
+ *  The batch is sent right away once it holds TCP_SESSION_TX_BATCH_SIZE
+ *  bytes.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was reserved on
+ *  uint8_t type: Frame type
+ *  uint32_t length: Payload length written, at most the reserved length
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_session_commit_frame(tcp_session_t *session, uint8_t type, uint32_t length)
+{
+    bool flush;
+    bool first = (0U == session->tx_len);
+
+    if(first)
+    {
+        session->tx_deadline = xTaskGetTickCount() +
+                               pdMS_TO_TICKS(TCP_SESSION_TX_FLUSH_LATENCY_MS);
+    }
+
+    tcp_frame_write_header(&session->tx_buffers[session->tx_fill][session->tx_len], type,
+                           length);
+    session->tx_len += TCP_FRAME_HEADER_LEN + length;
+    flush = (TCP_SESSION_TX_BATCH_SIZE == session->tx_len);
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    if(flush)
+    {
+        tcp_session_flush(session);
+    }
+    else if(first)
+    {
+        /* Let the TX task schedule the flush of the new batch. */
+        tcp_server_signal(SERVER_EVENT_TX_PENDING);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_queue_frame
+ *******************************************************************************
+ * Summary:
+ *  Appends a frame to the transmit batch of a session by copying the payload
+ *  into room reserved with tcp_session_reserve_frame(). Must be called
+ *  without the session table mutex held.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session to send the frame to
+ *  cy_socket_t socket_handle: Client socket the frame is meant for, or NULL
+ *   for whichever client is connected on the session
+ *  uint8_t type: Frame type
+ *  const uint8_t *payload: Frame payload
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  bool: true if the frame was queued.
+ *
+ *******************************************************************************/
+bool tcp_session_queue_frame(tcp_session_t *session, cy_socket_t socket_handle,
+                             uint8_t type, const uint8_t *payload, uint32_t length)
+{
+    uint8_t *frame_payload;
+
+    frame_payload = tcp_session_reserve_frame(session, socket_handle, length);
+    if(NULL == frame_payload)
+    {
+        return false;
+    }
+
+    memcpy(frame_payload, payload, length);
+    tcp_session_commit_frame(session, type, length);
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_flush
+ *******************************************************************************
+ * Summary:
+ *  Sends the transmit batch of a session as a single TLS record. The batch is
+ *  sent in place without the session table mutex held, while new frames
+ *  queue in the other batch buffer, so that a slow client only blocks the
+ *  task flushing it.
+ *  If another task is already sending for the session, it sends this batch
+ *  too once it is done. Must be called without the session table mutex held.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session whose batch is sent
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_session_flush(tcp_session_t *session)
+{
+    cy_rslt_t result;
+    cy_socket_t socket_handle;
+    uint32_t length;
+    uint8_t *batch;
+    bool stream_waiting;
+
+    /* Variable to store number of bytes sent over TCP socket. */
+    uint32_t bytes_sent;
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    if((TCP_SESSION_STATE_CONNECTED != session->state) || (0U == session->tx_len))
+    {
+        xSemaphoreGive(tcp_sessions_mutex);
+        return;
+    }
+
+    if(session->tx_busy)
+    {
+        session->tx_flush_requested = true;
+        xSemaphoreGive(tcp_sessions_mutex);
+        return;
+    }
+
+    session->tx_busy = true;
+    session->users++;
+    socket_handle = session->socket_handle;
+
+    do
+    {
+        length = session->tx_len;
+        batch = session->tx_buffers[session->tx_fill];
+        session->tx_fill ^= 1U;
+        session->tx_len = 0U;
+        session->tx_flush_requested = false;
+        xSemaphoreGive(tcp_sessions_mutex);
+
+        server_stats_track(SERVER_STATS_HWM_TX_BATCH, length);
+        bytes_sent = RESET_VAL;
+        trace_point(TRACE_EVENT_TX_START, (uint32_t)(session - tcp_sessions), length);
+        result = cy_socket_send(socket_handle, batch, length,
+                                CY_SOCKET_FLAGS_NONE, &bytes_sent);
+        trace_point(TRACE_EVENT_TX_DONE, (uint32_t)(session - tcp_sessions), bytes_sent);
+        server_stats_add(SERVER_STATS_BYTES_OUT, bytes_sent);
+
+        xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+        if(CY_RSLT_SUCCESS == result)
+        {
+            server_stats_add(SERVER_STATS_RECORDS_OUT, 1U);
+            if(session->request_pending)
+            {
+                session->request_pending = false;
+                power_policy_response_sent(session->request_start);
+            }
+        }
+        else
+        {
+            APP_LOG_ERROR("Failed to send to TCP client %u. Error: %"PRIu32"\n",
+                          (unsigned int)(session - tcp_sessions), result);
+            if(CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED == result)
+            {
+                /* Disconnect and delete the socket and free the slot once
+                 * this task is done with it. */
+                tcp_session_release(session);
+            }
+        }
+    } while((CY_RSLT_SUCCESS == result) && session->tx_flush_requested &&
+            (TCP_SESSION_STATE_CONNECTED == session->state) && (0U != session->tx_len));
+
+    session->tx_busy = false;
+    session->tx_flush_requested = false;
+    stream_waiting = session->stream.active;
+    tcp_session_put(session);
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    /* A block of the stream may wait for the send path. */
+    if(stream_waiting)
+    {
+        tcp_stream_wake();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_sessions_tx_pending
+ *******************************************************************************
+ * Summary:
+ *  Tells whether any session has frames queued in its transmit batch or a
+ *  send in progress. Reads the table without the mutex, as it is called from
+ *  the Deep Sleep callback; every field read is a single word, and the idle
+ *  task asks again before every Deep Sleep attempt.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool: true if a transmit batch is not empty or being sent.
+ *
+ *******************************************************************************/
+bool tcp_sessions_tx_pending(void)
+{
+    uint32_t index;
+
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        if((0U != tcp_sessions[index].tx_len) || tcp_sessions[index].tx_busy)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_sessions_flush_due
+ *******************************************************************************
+ * Summary:
+ *  Flushes every transmit batch whose deadline has passed.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  TickType_t: Ticks until the next pending batch is due, or portMAX_DELAY
+ *  if no batch is pending.
+ *
+ *******************************************************************************/
+TickType_t tcp_sessions_flush_due(void)
+{
+    TickType_t next_wait = portMAX_DELAY;
+    TickType_t now;
+    TickType_t remaining;
+    tcp_session_t *session;
+    uint32_t due = 0U;
+    uint32_t index;
+
+    /* Collect the due sessions first; the sends are made without the mutex. */
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    now = xTaskGetTickCount();
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        session = &tcp_sessions[index];
+        if((TCP_SESSION_STATE_CONNECTED != session->state) || (0U == session->tx_len))
+        {
+            continue;
+        }
+
+        if((int32_t)(session->tx_deadline - now) <= 0)
+        {
+            due |= (1UL << index);
+        }
+        else
+        {
+            remaining = session->tx_deadline - now;
+            if(remaining < next_wait)
+            {
+                next_wait = remaining;
+            }
+        }
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        if(0U != (due & (1UL << index)))
+        {
+            tcp_session_flush(&tcp_sessions[index]);
+        }
+    }
+
+    return next_wait;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_receive_msg_handler
+ *******************************************************************************
+ * Summary:
+ *  Callback function to handle incoming TCP client messages. The data is not
+ *  read here: the session is marked readable and the RX task reads and
+ *  dispatches it.
+ *
+ * Parameters:
+ * cy_socket_t socket_handle: Connection handle for the TCP client socket
+ *  void *args : Session owning the client socket
+ *
+ * Return:
+ *  cy_result result: Result of the operation
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_receive_msg_handler(cy_socket_t socket_handle, void *arg)
+{
+    tcp_session_t *session = (tcp_session_t *)arg;
+    bool open;
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    if(NULL == session)
+    {
+        session = tcp_session_find(socket_handle);
+    }
+    open = (NULL != session) && tcp_session_is_open(session, socket_handle);
+    if(open)
+    {
+        session->rx_ready = true;
+        if(!session->request_pending)
+        {
+            session->request_pending = true;
+            session->request_start = power_policy_request_start();
+        }
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    if(open)
+    {
+        trace_point(TRACE_EVENT_RX_READY, (uint32_t)(session - tcp_sessions), 0U);
+        tcp_server_signal(SERVER_EVENT_SOCKET_READABLE);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_sessions_receive_ready
+ *******************************************************************************
+ * Summary:
+ *  Reads from every session the receive callback marked readable.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_sessions_receive_ready(void)
+{
+    tcp_session_t *session;
+    uint32_t ready = 0U;
+    uint32_t index;
+
+    /* Keep the sessions and their sockets alive while reading from them; the
+     * reads are made without the mutex. */
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        session = &tcp_sessions[index];
+        if(session->rx_ready)
+        {
+            session->rx_ready = false;
+            if(tcp_session_is_open(session, NULL))
+            {
+                session->users++;
+                ready |= (1UL << index);
+            }
+        }
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        if(0U != (ready & (1UL << index)))
+        {
+            tcp_session_receive(&tcp_sessions[index]);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_receive
+ *******************************************************************************
+ * Summary:
+ *  Receives straight into the session buffer and dispatches every complete
+ *  frame in place, then drops the reference taken by the caller.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session to read from, with a reference held
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_session_receive(tcp_session_t *session)
+{
+    cy_rslt_t result;
+    cy_socket_t socket_handle = session->socket_handle;
+    bool frames_valid = true;
+    uint32_t room;
+
+    /* Variable to store number of bytes received from TCP client. */
+    uint32_t bytes_received = RESET_VAL;
+
+    /* Dispatch first the frames left in the buffer when the queue of the
+     * protocol was full. */
+    result = CY_RSLT_SUCCESS;
+    if(session->rx_stalled)
+    {
+        frames_valid = tcp_session_dispatch_frames(session);
+    }
+
+    /* Keep reading while a read fills the buffer, as more decrypted data may
+     * be waiting in the TLS record layer. Stop as soon as a frame handler
+     * finds the connection closed, or the queue of the protocol is full. */
+    while(frames_valid && !session->rx_stalled &&
+          (TCP_SESSION_STATE_CONNECTED == session->state))
+    {
+        room = TCP_SESSION_RX_BUFFER_SIZE - session->rx_tail;
+        trace_point(TRACE_EVENT_RX_START, (uint32_t)(session - tcp_sessions), 0U);
+        result = cy_socket_recv(socket_handle, &session->rx_buffer[session->rx_tail], room,
+                                CY_SOCKET_FLAGS_NONE, &bytes_received);
+        trace_point(TRACE_EVENT_RX_DONE, (uint32_t)(session - tcp_sessions),
+                    (CY_RSLT_SUCCESS == result) ? bytes_received : 0U);
+        if(CY_RSLT_SUCCESS != result)
+        {
+            break;
+        }
+
+        session->rx_tail += bytes_received;
+        session->last_activity = xTaskGetTickCount();
+        server_stats_add(SERVER_STATS_BYTES_IN, bytes_received);
+        server_stats_add(SERVER_STATS_RECV_CALLS, 1U);
+        server_stats_track(SERVER_STATS_HWM_RX_BUFFER, session->rx_tail - session->rx_head);
+        frames_valid = tcp_session_dispatch_frames(session);
+        if(bytes_received != room)
+        {
+            break;
+        }
+    }
+
+    if(CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT == result)
+    {
+        /* The drain loop found no more data. */
+        result = CY_RSLT_SUCCESS;
+    }
+
+    if(!frames_valid)
+    {
+        APP_LOG_WARN("Malformed frame from the secure TCP client. Closing the connection\n");
+    }
+    else if(CY_RSLT_SUCCESS != result)
+    {
+        APP_LOG_ERROR("Failed to receive acknowledgement from the secure TCP client. Error: %"PRIu32"\n",
+                      result);
+    }
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    if(!frames_valid || (CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED == result))
+    {
+        /* Disconnect and delete the socket and free the slot. */
+        tcp_session_release(session);
+    }
+    tcp_session_put(session);
+    xSemaphoreGive(tcp_sessions_mutex);
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_evict_lru
+ *******************************************************************************
+ * Summary:
+ *  Closes the least recently active session to make room for a new client,
+ *  if it has been idle for at least TCP_SESSION_EVICT_MIN_IDLE_MS. Sessions
+ *  that another task is using are only picked if no other session qualifies,
+ *  as their slot is freed once that task is done with it. Never waits for the
+ *  peer.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool: true if a slot was freed.
+ *
+ *******************************************************************************/
+bool tcp_session_evict_lru(void)
+{
+    tcp_session_t *session;
+    tcp_session_t *victim = NULL;
+    TickType_t now;
+    TickType_t idle;
+    TickType_t victim_idle = 0U;
+    bool freed = false;
+    uint32_t index;
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    now = xTaskGetTickCount();
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        session = &tcp_sessions[index];
+        if(TCP_SESSION_STATE_CONNECTED != session->state)
+        {
+            continue;
+        }
+
+        idle = now - session->last_activity;
+        if(idle < pdMS_TO_TICKS(TCP_SESSION_EVICT_MIN_IDLE_MS))
+        {
+            continue;
+        }
+
+        /* Prefer idle sessions with no task using them. */
+        if((NULL == victim) || ((0U != victim->users) && (0U == session->users)) ||
+           (((0U == victim->users) == (0U == session->users)) && (idle > victim_idle)))
+        {
+            victim = session;
+            victim_idle = idle;
+        }
+    }
+
+    if(NULL != victim)
+    {
+        index = (uint32_t)(victim - tcp_sessions);
+        tcp_session_release(victim);
+        freed = (TCP_SESSION_STATE_FREE == victim->state);
+        server_stats_add(SERVER_STATS_SESSIONS_EVICTED, 1U);
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    if(NULL != victim)
+    {
+        APP_LOG_INFO("Session table full. TCP client %"PRIu32" evicted after %"PRIu32
+                     " ms without activity\n", index,
+                     (uint32_t)(victim_idle * portTICK_PERIOD_MS));
+    }
+
+    return freed;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_sessions_evict_idle
+ *******************************************************************************
+ * Summary:
+ *  Closes every session that received nothing for TCP_SESSION_IDLE_TIMEOUT_MS.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  TickType_t: Ticks until the next session may become idle, or
+ *  portMAX_DELAY if no session is connected.
+ *
+ *******************************************************************************/
+TickType_t tcp_sessions_evict_idle(void)
+{
+    TickType_t next_wait = portMAX_DELAY;
+#if (TCP_SESSION_IDLE_TIMEOUT_MS > 0U)
+    const TickType_t timeout = pdMS_TO_TICKS(TCP_SESSION_IDLE_TIMEOUT_MS);
+    tcp_session_t *session;
+    TickType_t now;
+    TickType_t idle;
+    uint32_t evicted = 0U;
+    uint32_t index;
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    now = xTaskGetTickCount();
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        session = &tcp_sessions[index];
+        if(TCP_SESSION_STATE_CONNECTED != session->state)
+        {
+            continue;
+        }
+
+        idle = now - session->last_activity;
+        if(idle >= timeout)
+        {
+            tcp_session_release(session);
+            evicted++;
+        }
+        else if((timeout - idle) < next_wait)
+        {
+            next_wait = timeout - idle;
+        }
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    if(0U != evicted)
+    {
+        server_stats_add(SERVER_STATS_SESSIONS_EVICTED, evicted);
+        APP_LOG_INFO("Closed %"PRIu32" TCP client(s) idle for %"PRIu32" ms\n", evicted,
+                     (uint32_t)TCP_SESSION_IDLE_TIMEOUT_MS);
+    }
+#endif
+
+    return next_wait;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_frame_write_header
+ *******************************************************************************
+ * Summary:
+ *  Writes the header of an application frame.
+ *
+ * Parameters:
+ *  uint8_t *frame: Start of the frame
+ *  uint8_t type: Frame type
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_frame_write_header(uint8_t *frame, uint8_t type, uint32_t length)
+{
+    frame[0] = type;
+    frame[1] = (uint8_t)(length >> 8);
+    frame[2] = (uint8_t)length;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_session_dispatch_frames
+ *******************************************************************************
+ * Summary:
+ *  Decodes every complete frame of the session receive buffer and hands it to
+ *  the protocol of the session. A trailing incomplete frame stays in the
+ *  buffer until the rest of it is received. Decoding stops once a handler
+ *  finds the connection closed, or once the queue of the protocol is full, in
+ *  which case the remaining frames stay in the buffer and rx_stalled is set.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session whose receive buffer is decoded
+ *
+ * Return:
+ *  bool: false if the client sent a frame that can never fit the buffer.
+ *
+ *******************************************************************************/
+static bool tcp_session_dispatch_frames(tcp_session_t *session)
+{
+    const uint8_t *frame;
+    uint32_t length;
+    uint8_t type;
+
+    session->rx_stalled = false;
+
+    /* The caller holds a reference on the session, so its state can only
+     * move from CONNECTED to CLOSING meanwhile and is read without the mutex. */
+    while((TCP_SESSION_STATE_CONNECTED == session->state) &&
+          ((session->rx_tail - session->rx_head) >= TCP_FRAME_HEADER_LEN))
+    {
+        frame = &session->rx_buffer[session->rx_head];
+        type = frame[0];
+        length = ((uint32_t)frame[1] << 8) | frame[2];
+
+        if(length > TCP_FRAME_MAX_PAYLOAD_LEN)
+        {
+            return false;
+        }
+
+        if((session->rx_tail - session->rx_head) < (TCP_FRAME_HEADER_LEN + length))
+        {
+            break;
+        }
+
+        if(TCP_FRAME_TYPE_PROTOCOL_SELECT == type)
+        {
+            tcp_session_select_protocol(session, &frame[TCP_FRAME_HEADER_LEN], length);
+        }
+        else if(!tcp_session_handle_frame(session, type, &frame[TCP_FRAME_HEADER_LEN], length))
+        {
+            session->rx_stalled = true;
+            break;
+        }
+
+        session->rx_head += TCP_FRAME_HEADER_LEN + length;
+    }
+
+    if(session->rx_head == session->rx_tail)
+    {
+        session->rx_head = 0U;
+        session->rx_tail = 0U;
+    }
+    else if(TCP_SESSION_RX_BUFFER_SIZE == session->rx_tail)
+    {
+        /* Make room for the rest of the incomplete frame. */
+        memmove(session->rx_buffer, &session->rx_buffer[session->rx_head],
+                session->rx_tail - session->rx_head);
+        session->rx_tail -= session->rx_head;
+        session->rx_head = 0U;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_disconnection_handler
+ *******************************************************************************
+ * Summary:
+ *  Callback function to handle TCP client disconnection event.
+ *
+ * Parameters:
+ * cy_socket_t socket_handle: Connection handle for the TCP client socket
+ *  void *args : Session owning the client socket
+ *
+ * Return:
+ *  cy_result result: Result of the operation
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_disconnection_handler(cy_socket_t socket_handle, void *arg)
+{
+    tcp_session_t *session = (tcp_session_t *)arg;
+    app_state_snapshot_t state;
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    if(NULL == session)
+    {
+        session = tcp_session_find(socket_handle);
+    }
+
+    /* The slot may already have been released by a failed send or receive. */
+    if((NULL != session) && (socket_handle == session->socket_handle))
+    {
+        /* Disconnect and delete the socket and free the slot. */
+        tcp_session_release(session);
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    app_state_snapshot(&state);
+    APP_LOG_INFO("TCP Client disconnected! Connected TCP clients: %"PRIu32"\n"
+                 "===============================================================\n"
+                 "Listening for incoming TCP client connection on Port:%d\n",
+                 state.connected_clients, TCP_SERVER_PORT);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,215 @@
+/******************************************************************************
+* File Name:   tcp_session.h
+*
+* Description: This file contains the secure TCP client session table shared by the
+* server, listener, protocol and stream modules.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TCP_SESSION_H_
+#define TCP_SESSION_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_result.h"
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include "cy_secure_sockets.h"
+#include "ip_addr.h"
+#include "secure_tcp_server.h"
+#include "ipc_offload.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+#define RESET_VAL                                 (0U)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* State of a slot in the secure TCP client session table. */
+typedef enum
+{
+    TCP_SESSION_STATE_FREE = 0,
+    TCP_SESSION_STATE_ACCEPTING,
+    TCP_SESSION_STATE_CONNECTED,
+    /* Released while a task still uses the socket outside the table mutex.
+     * The last user deletes the socket and frees the slot. */
+    TCP_SESSION_STATE_CLOSING
+} tcp_session_state_t;
+
+/* Application protocols, indexed as in tcp_protocols. */
+typedef enum
+{
+    TCP_PROTOCOL_CONTROL = 0,
+    TCP_PROTOCOL_TELEMETRY,
+    TCP_PROTOCOL_COUNT
+} tcp_protocol_id_t;
+
+/* Stream of sensor blocks sent to a session. limited is set if the client
+ * asked for a given number of blocks, which remaining counts down; stopping
+ * is set once the client asked to stop. cycles counts the CPU cycles spent
+ * sending the blocks. */
+typedef struct
+{
+    bool active;
+    bool limited;
+    bool stopping;
+    uint32_t credits;
+    uint32_t remaining;
+    uint32_t sequence;
+    uint32_t blocks;
+    uint32_t bytes;
+    uint64_t cycles;
+    TickType_t start;
+} tcp_stream_t;
+
+/* Secure TCP client session. The address of the slot is registered as the
+ * callback argument of the client socket, so that the receive and disconnect
+ * callbacks find their session without searching the table.
+ *
+ * The table mutex protects the state, the users count and the transmit batch.
+ * Blocking socket calls are made without it: the caller first counts itself
+ * in users, which keeps the socket and the slot alive until it is done.
+ */
+typedef struct
+{
+    tcp_session_state_t state;
+    cy_socket_t socket_handle;
+    uint32_t users;
+    cy_socket_sockaddr_t peer_addr;
+    uint32_t peer_addr_len;
+
+    /* Printable peer address. Log records refer to it, so it is kept until
+     * the slot is reused. */
+    char peer_name[IPADDR_STRLEN_MAX];
+
+    /* Receive buffer. Bytes between rx_head and rx_tail are received but not
+     * yet dispatched; an incomplete frame is moved to the start of the buffer
+     * only once it reaches the end of the buffer. */
+    uint32_t rx_head;
+    uint32_t rx_tail;
+    uint8_t rx_buffer[TCP_SESSION_RX_BUFFER_SIZE];
+
+    /* Transmit batch. tx_deadline is the tick by which a non-empty batch must
+     * be flushed. Frames are queued in tx_buffers[tx_fill]; a flush sends that
+     * buffer in place and moves tx_fill to the other one. While tx_busy is
+     * set, one task sends the previous batch and new frames keep queuing in
+     * the other buffer; a flush asked for in the meantime is left to that
+     * task through tx_flush_requested. */
+    uint32_t tx_len;
+    uint32_t tx_fill;
+    TickType_t tx_deadline;
+    bool tx_busy;
+    bool tx_flush_requested;
+    uint8_t tx_buffers[2][TCP_SESSION_TX_BATCH_SIZE];
+
+    /* Set by the receive callback, cleared by the RX task before it reads
+     * from the socket. */
+    bool rx_ready;
+
+    /* Set by the receive callback with the time the request arrived, see
+     * power_policy_request_start(), and cleared once a response is sent. */
+    bool request_pending;
+    uint32_t request_start;
+
+    /* Tick of the handshake or of the last data received from the client. */
+    TickType_t last_activity;
+
+    /* Protocol selected by the client, and whether the RX task stopped
+     * reading because the queue of that protocol is full. Only used by the
+     * RX task. */
+    tcp_protocol_id_t protocol;
+    bool rx_stalled;
+
+    /* Core the DATA frames of the session are processed on, chosen by
+     * ipc_offload_attach() once the session is connected. */
+    ipc_offload_core_t core;
+
+    /* Stream of sensor blocks, protected by the table mutex. */
+    tcp_stream_t stream;
+} tcp_session_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Secure TCP client session table and the mutex protecting it. */
+extern tcp_session_t tcp_sessions[TCP_SERVER_MAX_CLIENTS];
+extern SemaphoreHandle_t tcp_sessions_mutex;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t tcp_sessions_init(void);
+tcp_session_t *tcp_session_alloc(void);
+bool tcp_session_is_open(const tcp_session_t *session, cy_socket_t socket_handle);
+void tcp_session_release(tcp_session_t *session);
+void tcp_session_put(tcp_session_t *session);
+cy_rslt_t tcp_session_register_callbacks(tcp_session_t *session);
+bool tcp_session_evict_lru(void);
+TickType_t tcp_sessions_evict_idle(void);
+void tcp_sessions_receive_ready(void);
+
+void tcp_frame_write_header(uint8_t *frame, uint8_t type, uint32_t length);
+uint8_t *tcp_session_reserve_frame(tcp_session_t *session, cy_socket_t socket_handle,
+                                   uint32_t max_length);
+void tcp_session_commit_frame(tcp_session_t *session, uint8_t type, uint32_t length);
+bool tcp_session_queue_frame(tcp_session_t *session, cy_socket_t socket_handle,
+                             uint8_t type, const uint8_t *payload, uint32_t length);
+void tcp_session_flush(tcp_session_t *session);
+TickType_t tcp_sessions_flush_due(void);
+bool tcp_sessions_tx_pending(void);
+
+cy_rslt_t tcp_receive_msg_handler(cy_socket_t socket_handle, void *arg);
+cy_rslt_t tcp_disconnection_handler(cy_socket_t socket_handle, void *arg);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* TCP_SESSION_H_ */
+
+/* [] END OF FILE */
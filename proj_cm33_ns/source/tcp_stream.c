@@ -0,0 +1,532 @@
+/******************************************************************************
+* File Name:   tcp_stream.c
+*
+* Description: This file contains the streaming of sensor blocks to the telemetry
+* clients, sent against the credits the clients grant.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+
+/* Standard C header file */
+#include <string.h>
+/* To use the portable formatting macros */
+#include <inttypes.h>
+
+/* Secure socket header file. */
+#include "cy_secure_sockets.h"
+
+/* mbedTLS header file */
+#include "mbedtls/ssl.h"
+
+/* Secure TCP server header file */
+#include "secure_tcp_server.h"
+
+/* Session table header file */
+#include "tcp_session.h"
+
+/* Streaming header file */
+#include "tcp_stream.h"
+
+/* Runtime performance counters header file */
+#include "server_stats.h"
+
+/* Deferred logger header file */
+#include "app_log.h"
+
+/* Stream block producer header file */
+#include "stream_source.h"
+
+/* Cycle counter header file */
+#include "cycle_counter.h"
+
+/* Trace ring header file */
+#include "trace_ring.h"
+
+/* A block goes out as a single frame, in a single TLS record. */
+_Static_assert((STREAM_SOURCE_HEADROOM >= (TCP_FRAME_HEADER_LEN + TCP_FRAME_STREAM_SEQUENCE_LEN)) &&
+               ((TCP_FRAME_HEADER_LEN + TCP_FRAME_STREAM_SEQUENCE_LEN + STREAM_SOURCE_BLOCK_LEN) <=
+                MBEDTLS_SSL_OUT_CONTENT_LEN),
+               "A stream block must fit its headroom and one TLS record");
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+
+static void tcp_stream_task(void *arg);
+static TickType_t tcp_streams_service(void);
+static void tcp_stream_send_block(tcp_session_t *session, uint8_t *block);
+static void tcp_stream_finish(tcp_session_t *session);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Task sending the stream blocks. */
+static TaskHandle_t tcp_stream_task_handle;
+
+/*******************************************************************************
+ * Function Name: tcp_stream_init
+ *******************************************************************************
+ * Summary:
+ *  Starts the block producer and creates the stream task.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_result result: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t tcp_stream_init(void)
+{
+    cy_rslt_t result;
+
+    result = stream_source_init(tcp_stream_wake);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    if(pdPASS != xTaskCreate(tcp_stream_task, "Stream task", TCP_STREAM_TASK_STACK_SIZE,
+                             NULL, TCP_STREAM_TASK_PRIORITY, &tcp_stream_task_handle))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_stream_wake
+ *******************************************************************************
+ * Summary:
+ *  Wakes the stream task after something a stream may wait for happened: a
+ *  block was filled or the send path of a session was freed.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_stream_wake(void)
+{
+    if(NULL != tcp_stream_task_handle)
+    {
+        xTaskNotifyGive(tcp_stream_task_handle);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_stream_start_frame_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles a STREAM_START frame. Starts, or starts over, the stream of the
+ *  session, without credits: the client grants them once it is ready.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Number of blocks to send, 0 until STREAM_STOP
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_stream_start_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                    uint32_t length)
+{
+    uint32_t blocks;
+
+    if(TCP_FRAME_STREAM_START_LEN != length)
+    {
+        return;
+    }
+
+    blocks = ((uint32_t)payload[0] << 24) | ((uint32_t)payload[1] << 16) |
+             ((uint32_t)payload[2] << 8) | payload[3];
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    memset(&session->stream, 0, sizeof(session->stream));
+    session->stream.active = true;
+    session->stream.limited = (0U != blocks);
+    session->stream.remaining = blocks;
+    session->stream.start = xTaskGetTickCount();
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    APP_LOG_INFO("Stream to TCP client %u started\n", (unsigned int)(session - tcp_sessions));
+}
+
+/*******************************************************************************
+ * Function Name: tcp_stream_credit_frame_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles a STREAM_CREDIT frame by adding the granted blocks to the credits
+ *  of the stream, up to TCP_STREAM_MAX_CREDITS, and waking the stream task.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Number of blocks granted
+ *  uint32_t length: Payload length
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_stream_credit_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                     uint32_t length)
+{
+    uint32_t credits;
+
+    if(TCP_FRAME_STREAM_CREDIT_LEN != length)
+    {
+        return;
+    }
+
+    credits = ((uint32_t)payload[0] << 8) | payload[1];
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    if(session->stream.active)
+    {
+        credits += session->stream.credits;
+        session->stream.credits = (credits > TCP_STREAM_MAX_CREDITS) ?
+                                  TCP_STREAM_MAX_CREDITS : credits;
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    xTaskNotifyGive(tcp_stream_task_handle);
+}
+
+/*******************************************************************************
+ * Function Name: tcp_stream_stop_frame_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles a STREAM_STOP frame. The stream task ends the stream and sends the
+ *  report once the block it may be sending is out.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session the frame was received on
+ *  const uint8_t *payload: Frame payload (unused)
+ *  uint32_t length: Payload length (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void tcp_stream_stop_frame_handler(tcp_session_t *session, const uint8_t *payload,
+                                   uint32_t length)
+{
+    CY_UNUSED_PARAMETER(payload);
+    CY_UNUSED_PARAMETER(length);
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    session->stream.stopping = true;
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    xTaskNotifyGive(tcp_stream_task_handle);
+}
+
+/*******************************************************************************
+ * Function Name: tcp_stream_task
+ *******************************************************************************
+ * Summary:
+ *  Stream task. Sends the blocks of every stream against its credits, one
+ *  block per stream in turn, and sleeps once no stream can send until a
+ *  credit, a stop request, a filled block or a free send path wakes it. The
+ *  sends are made here rather than on the TX task, so that the transmit
+ *  batches never wait for a stream.
+ *
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_stream_task(void *arg)
+{
+    TickType_t wait;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    while(true)
+    {
+        wait = tcp_streams_service();
+        if(0U != wait)
+        {
+            (void)ulTaskNotifyTake(pdTRUE, wait);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tcp_streams_service
+ *******************************************************************************
+ * Summary:
+ *  Visits every stream once: ends the streams that are done and sends one
+ *  block to every stream that holds a credit.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  TickType_t: 0 if a block was sent, portMAX_DELAY if no stream can send
+ *  before the stream task is woken.
+ *
+ *******************************************************************************/
+static TickType_t tcp_streams_service(void)
+{
+    tcp_session_t *session;
+    tcp_stream_t *stream;
+    uint8_t *block;
+    TickType_t wait = portMAX_DELAY;
+    uint32_t index;
+
+    for(index = 0; index < TCP_SERVER_MAX_CLIENTS; index++)
+    {
+        session = &tcp_sessions[index];
+        stream = &session->stream;
+        block = NULL;
+
+        xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+        if(!tcp_session_is_open(session, NULL) || !stream->active)
+        {
+            xSemaphoreGive(tcp_sessions_mutex);
+            continue;
+        }
+
+        if(stream->stopping || (stream->limited && (0U == stream->remaining)))
+        {
+            session->users++;
+            xSemaphoreGive(tcp_sessions_mutex);
+            tcp_stream_finish(session);
+            continue;
+        }
+
+        if(0U != stream->credits)
+        {
+            /* The send path of the session is shared with its transmit
+             * batch; the flush of the batch and the producer wake the task
+             * once the send path is free and a block is filled. */
+            block = session->tx_busy ? NULL : stream_source_acquire(0U);
+            if(NULL != block)
+            {
+                session->tx_busy = true;
+                session->users++;
+            }
+        }
+        xSemaphoreGive(tcp_sessions_mutex);
+
+        if(NULL != block)
+        {
+            tcp_stream_send_block(session, block);
+            wait = 0U;
+        }
+    }
+
+    return wait;
+}
+
+/*******************************************************************************
+ * Function Name: tcp_stream_send_block
+ *******************************************************************************
+ * Summary:
+ *  Sends a block of a stream as one STREAM_DATA frame, straight from the
+ *  block, and returns the block to the producer. A flush of the transmit
+ *  batch asked for meanwhile is made once the block is out. The caller has
+ *  claimed the send path of the session and holds a reference on it.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session to send the block to
+ *  uint8_t *block: Filled block, with its headroom
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_stream_send_block(tcp_session_t *session, uint8_t *block)
+{
+    const uint32_t frame_len = TCP_FRAME_HEADER_LEN + TCP_FRAME_STREAM_SEQUENCE_LEN +
+                               STREAM_SOURCE_BLOCK_LEN;
+    uint8_t *frame = &block[STREAM_SOURCE_HEADROOM - TCP_FRAME_HEADER_LEN -
+                            TCP_FRAME_STREAM_SEQUENCE_LEN];
+    cy_rslt_t result;
+    uint32_t sequence;
+    uint32_t bytes_sent = RESET_VAL;
+    uint32_t cycles;
+    bool flush;
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    sequence = session->stream.sequence++;
+    session->stream.credits--;
+    if(session->stream.limited)
+    {
+        session->stream.remaining--;
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    tcp_frame_write_header(frame, TCP_FRAME_TYPE_STREAM_DATA,
+                           TCP_FRAME_STREAM_SEQUENCE_LEN + STREAM_SOURCE_BLOCK_LEN);
+    frame[3] = (uint8_t)(sequence >> 24);
+    frame[4] = (uint8_t)(sequence >> 16);
+    frame[5] = (uint8_t)(sequence >> 8);
+    frame[6] = (uint8_t)sequence;
+
+    trace_point(TRACE_EVENT_TX_START, (uint32_t)(session - tcp_sessions), frame_len);
+    cycles = cycle_counter_read();
+    result = cy_socket_send(session->socket_handle, frame, frame_len, CY_SOCKET_FLAGS_NONE,
+                            &bytes_sent);
+    cycles = cycle_counter_read() - cycles;
+    trace_point(TRACE_EVENT_TX_DONE, (uint32_t)(session - tcp_sessions), bytes_sent);
+    stream_source_release(block);
+    server_stats_add(SERVER_STATS_BYTES_OUT, bytes_sent);
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    session->tx_busy = false;
+    flush = session->tx_flush_requested;
+    session->tx_flush_requested = false;
+    if(CY_RSLT_SUCCESS == result)
+    {
+        server_stats_add(SERVER_STATS_RECORDS_OUT, 1U);
+        session->stream.blocks++;
+        session->stream.bytes += bytes_sent;
+        session->stream.cycles += cycles;
+    }
+    else
+    {
+        APP_LOG_ERROR("Failed to stream to TCP client %u. Error: %"PRIu32"\n",
+                      (unsigned int)(session - tcp_sessions), result);
+        session->stream.active = false;
+        if(CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED == result)
+        {
+            tcp_session_release(session);
+        }
+    }
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    if(flush)
+    {
+        tcp_session_flush(session);
+    }
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    tcp_session_put(session);
+    xSemaphoreGive(tcp_sessions_mutex);
+}
+
+/*******************************************************************************
+ * Function Name: tcp_stream_finish
+ *******************************************************************************
+ * Summary:
+ *  Ends the stream of a session and sends the STREAM_REPORT frame with its
+ *  throughput and the CPU load of its sends. The caller holds a reference on
+ *  the session, which is dropped here.
+ *
+ * Parameters:
+ *  tcp_session_t *session: Session whose stream ends
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void tcp_stream_finish(tcp_session_t *session)
+{
+    uint8_t report[TCP_FRAME_STREAM_REPORT_LEN];
+    tcp_stream_t stream;
+    uint32_t duration_ms;
+    uint32_t rate;
+    uint32_t permille;
+    uint64_t window_cycles;
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    stream = session->stream;
+    session->stream.active = false;
+    xSemaphoreGive(tcp_sessions_mutex);
+
+    duration_ms = (uint32_t)((xTaskGetTickCount() - stream.start) * portTICK_PERIOD_MS);
+    if(0U == duration_ms)
+    {
+        duration_ms = 1U;
+    }
+    rate = (uint32_t)(((uint64_t)stream.bytes * 1000U) / duration_ms);
+    window_cycles = (uint64_t)duration_ms * (SystemCoreClock / 1000U);
+    permille = (uint32_t)((stream.cycles * 1000U) / window_cycles);
+
+    report[0] = (uint8_t)(stream.blocks >> 24);
+    report[1] = (uint8_t)(stream.blocks >> 16);
+    report[2] = (uint8_t)(stream.blocks >> 8);
+    report[3] = (uint8_t)stream.blocks;
+    report[4] = (uint8_t)(stream.bytes >> 24);
+    report[5] = (uint8_t)(stream.bytes >> 16);
+    report[6] = (uint8_t)(stream.bytes >> 8);
+    report[7] = (uint8_t)stream.bytes;
+    report[8] = (uint8_t)(duration_ms >> 24);
+    report[9] = (uint8_t)(duration_ms >> 16);
+    report[10] = (uint8_t)(duration_ms >> 8);
+    report[11] = (uint8_t)duration_ms;
+    report[12] = (uint8_t)(rate >> 24);
+    report[13] = (uint8_t)(rate >> 16);
+    report[14] = (uint8_t)(rate >> 8);
+    report[15] = (uint8_t)rate;
+    report[16] = (uint8_t)(permille >> 8);
+    report[17] = (uint8_t)permille;
+
+    APP_LOG_INFO("Stream to TCP client %u done: %"PRIu32" blocks in %"PRIu32" ms, "
+                 "%"PRIu32" KB/s, %"PRIu32".%"PRIu32" %% CPU\n",
+                 (unsigned int)(session - tcp_sessions), stream.blocks, duration_ms,
+                 rate / 1024U, permille / 10U, permille % 10U);
+
+    if(tcp_session_queue_frame(session, NULL, TCP_FRAME_TYPE_STREAM_REPORT,
+                               report, sizeof(report)))
+    {
+        tcp_session_flush(session);
+    }
+
+    xSemaphoreTake(tcp_sessions_mutex, portMAX_DELAY);
+    tcp_session_put(session);
+    xSemaphoreGive(tcp_sessions_mutex);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,196 @@
+/******************************************************************************
+* File Name:   trace_ring.c
+*
+* Description: This file implements the trace ring: a RAM ring of records stamped
+* * with the DWT cycle counter, written lock-free from tasks and interrupt
+* * handlers and read out by the TRACE_REQ frame of the control protocol.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+#include "trace_ring.h"
+
+/* Standard C header files */
+#include <stdatomic.h>
+
+/* Cycle counter header file */
+#include "cycle_counter.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define TRACE_RING_MASK                           (TRACE_RING_SIZE - 1U)
+
+#if ((TRACE_RING_SIZE & TRACE_RING_MASK) != 0U)
+#error "TRACE_RING_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Records ever written; the writers claim their slot by incrementing it. */
+static atomic_uint_least32_t trace_head;
+
+/* Set while the ring is read out, so that the records being read are not
+ * overwritten. */
+static atomic_bool trace_frozen;
+
+/* Records written when the ring was frozen; the read-out works from this
+ * count, as a late writer may still move trace_head. */
+static uint32_t trace_frozen_head;
+
+static trace_record_t trace_records[TRACE_RING_SIZE];
+
+/*******************************************************************************
+ * Function Name: trace_ring_write
+ *******************************************************************************
+ * Summary:
+ *  Adds a record to the ring, overwriting the oldest one once the ring is
+ *  full. Records written while the ring is frozen are discarded. Writers
+ *  never block each other: each claims its own slot.
+ *
+ * Parameters:
+ *  trace_event_t event: Trace point
+ *  uint32_t session: Index of the session, or TRACE_NO_SESSION
+ *  uint32_t value: Value of the trace point, truncated to 16 bits
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void trace_ring_write(trace_event_t event, uint32_t session, uint32_t value)
+{
+    uint32_t cycles = cycle_counter_read();
+    trace_record_t *record;
+
+    if(atomic_load_explicit(&trace_frozen, memory_order_relaxed))
+    {
+        return;
+    }
+
+    record = &trace_records[atomic_fetch_add_explicit(&trace_head, 1U, memory_order_relaxed) &
+                            TRACE_RING_MASK];
+    record->cycles = cycles;
+    record->event = (uint8_t)event;
+    record->session = (uint8_t)session;
+    record->value = (uint16_t)value;
+}
+
+/*******************************************************************************
+ * Function Name: trace_ring_freeze
+ *******************************************************************************
+ * Summary:
+ *  Stops recording so that the ring can be read out with trace_ring_read().
+ *  A writer that was already past the check may still complete one record.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t: Number of records held by the ring.
+ *
+ *******************************************************************************/
+uint32_t trace_ring_freeze(void)
+{
+    atomic_store(&trace_frozen, true);
+    trace_frozen_head = atomic_load(&trace_head);
+
+    return (trace_frozen_head < TRACE_RING_SIZE) ? trace_frozen_head : TRACE_RING_SIZE;
+}
+
+/*******************************************************************************
+ * Function Name: trace_ring_read
+ *******************************************************************************
+ * Summary:
+ *  Copies records of the ring frozen by trace_ring_freeze(), oldest first.
+ *
+ * Parameters:
+ *  uint32_t first: Index of the first record to copy, 0 being the oldest
+ *  trace_record_t *records: Destination of the records
+ *  uint32_t count: Largest number of records to copy
+ *
+ * Return:
+ *  uint32_t: Number of records copied.
+ *
+ *******************************************************************************/
+uint32_t trace_ring_read(uint32_t first, trace_record_t *records, uint32_t count)
+{
+    uint32_t head = trace_frozen_head;
+    uint32_t held = (head < TRACE_RING_SIZE) ? head : TRACE_RING_SIZE;
+    uint32_t oldest = head - held;
+    uint32_t index;
+
+    if(first >= held)
+    {
+        return 0U;
+    }
+
+    if(count > (held - first))
+    {
+        count = held - first;
+    }
+
+    for(index = 0U; index < count; index++)
+    {
+        records[index] = trace_records[(oldest + first + index) & TRACE_RING_MASK];
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+ * Function Name: trace_ring_resume
+ *******************************************************************************
+ * Summary:
+ *  Clears the ring and resumes recording after a read-out.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void trace_ring_resume(void)
+{
+    atomic_store(&trace_head, 0U);
+    atomic_store(&trace_frozen, false);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,148 @@
+/******************************************************************************
+* File Name:   trace_ring.h
+*
+* Description: This file is the public interface of trace_ring.c, the RAM ring of
+* * cycle-stamped trace points on the accept, receive, send and button paths
+* * of the secure TCP server.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TRACE_RING_H_
+#define TRACE_RING_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Set to 0 to compile the trace points out. */
+#define TRACE_RING_ENABLE                         (1U)
+
+/* Number of records the ring holds. Must be a power of two. Once the ring is
+ * full, every record overwrites the oldest one. */
+#define TRACE_RING_SIZE                           (256U)
+
+/* Session index of the records that do not belong to a session. */
+#define TRACE_NO_SESSION                          (0xFFU)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Trace points. The values are part of the TRACE_RSP frame. */
+typedef enum
+{
+    /* Entry of the user button ISR. */
+    TRACE_EVENT_BUTTON_ISR = 1,
+    /* LED command of a button event queued to a session. */
+    TRACE_EVENT_LED_QUEUED,
+    /* Connection request reported by the secure sockets library. */
+    TRACE_EVENT_ACCEPT_READY,
+    /* Handshake worker starting and ending an accept; value is 1 if the
+     * handshake succeeded. */
+    TRACE_EVENT_ACCEPT_START,
+    TRACE_EVENT_ACCEPT_DONE,
+    /* Receive callback of a client socket. */
+    TRACE_EVENT_RX_READY,
+    /* Call to cy_socket_recv(); value is the number of bytes received. */
+    TRACE_EVENT_RX_START,
+    TRACE_EVENT_RX_DONE,
+    /* Call to cy_socket_send(); value is the number of bytes sent. */
+    TRACE_EVENT_TX_START,
+    TRACE_EVENT_TX_DONE,
+    TRACE_EVENT_COUNT
+} trace_event_t;
+
+/* One trace record. cycles is the DWT cycle counter at the trace point. */
+typedef struct
+{
+    uint32_t cycles;
+    uint8_t event;
+    uint8_t session;
+    uint16_t value;
+} trace_record_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void trace_ring_write(trace_event_t event, uint32_t session, uint32_t value);
+uint32_t trace_ring_freeze(void);
+uint32_t trace_ring_read(uint32_t first, trace_record_t *records, uint32_t count);
+void trace_ring_resume(void);
+
+/*******************************************************************************
+ * Function Name: trace_point
+ *******************************************************************************
+ * Summary:
+ *  Records a trace point, unless tracing is compiled out. Safe to call from
+ *  any task or interrupt handler.
+ *
+ * Parameters:
+ *  trace_event_t event: Trace point
+ *  uint32_t session: Index of the session, or TRACE_NO_SESSION
+ *  uint32_t value: Value of the trace point, truncated to 16 bits
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static inline void trace_point(trace_event_t event, uint32_t session, uint32_t value)
+{
+#if (TRACE_RING_ENABLE)
+    trace_ring_write(event, session, value);
+#else
+    (void)event;
+    (void)session;
+    (void)value;
+#endif
+}
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* TRACE_RING_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,342 @@
+/******************************************************************************
+* File Name:   ipc_offload_worker.c
+*
+* Description: This file contains the CM55 side of the IPC pipeline
+* through which CM33 offloads frame processing. The worker task executes the
+* descriptors CM33 queues in shared memory and reports their completion
+* through the completion doorbell.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* Header file includes */
+#include "cybsp.h"
+
+/* FreeRTOS header file */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* DWT cycle counter header file */
+#include "cycle_counter.h"
+
+/* IPC offload worker header file */
+#include "ipc_offload_worker.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define IPC_OFFLOAD_DESC_MASK                          (IPC_OFFLOAD_DESC_COUNT - 1U)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+
+/* Shared block, owned by CM33. Its address is the message word of the
+ * request doorbell, and it is only used once its header checked out. */
+static ipc_offload_shared_t *ipc_offload_shared;
+
+/* Request doorbells whose message word was not the address of a valid block,
+ * kept for inspection with a debugger. */
+static volatile uint32_t foreign_doorbells;
+
+static TaskHandle_t worker_task_handle;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void ipc_offload_worker_task(void *arg);
+static ipc_offload_shared_t *ipc_offload_worker_bind(void);
+static void ipc_offload_request_isr(void);
+static void ipc_offload_cache_invalidate(volatile void *addr, uint32_t size);
+static void ipc_offload_cache_clean(volatile void *addr, uint32_t size);
+
+/*******************************************************************************
+ * Function Name: ipc_offload_worker_init
+ *******************************************************************************
+ * Summary:
+ *  Creates the worker task and enables the request doorbell interrupt.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  cy_rslt_t: Result of the operation.
+ *
+ *******************************************************************************/
+cy_rslt_t ipc_offload_worker_init(void)
+{
+    cy_stc_sysint_t request_intr_cfg =
+    {
+        .intrSrc = IPC_OFFLOAD_REQ_IRQ,
+        .intrPriority = IPC_OFFLOAD_REQ_IRQ_PRIORITY
+    };
+
+    if(pdPASS != xTaskCreate(ipc_offload_worker_task, "Offload worker",
+                             IPC_OFFLOAD_WORKER_TASK_STACK_SIZE, NULL,
+                             IPC_OFFLOAD_WORKER_TASK_PRIORITY, &worker_task_handle))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    if(CY_SYSINT_SUCCESS != Cy_SysInt_Init(&request_intr_cfg, ipc_offload_request_isr))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    Cy_IPC_Drv_SetInterruptMask(Cy_IPC_Drv_GetIntrBaseAddr(IPC_OFFLOAD_REQ_INTR),
+                                CY_IPC_NO_NOTIFICATION, 1UL << IPC_OFFLOAD_REQ_CHANNEL);
+    NVIC_EnableIRQ(request_intr_cfg.intrSrc);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_request_isr
+ *******************************************************************************
+ * Summary:
+ *  Request doorbell interrupt handler. Releases the doorbell before waking
+ *  the worker, so that a request queued while the worker drains the ring
+ *  rings the doorbell again. A doorbell that does not carry the address of
+ *  the bound block is counted and ignored. Before the worker is bound, the
+ *  doorbell is left to ipc_offload_worker_bind().
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_request_isr(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    IPC_STRUCT_Type *ipc_base = Cy_IPC_Drv_GetIpcBaseAddress(IPC_OFFLOAD_REQ_CHANNEL);
+    uint32_t message = 0U;
+
+    Cy_IPC_Drv_ClearInterrupt(Cy_IPC_Drv_GetIntrBaseAddr(IPC_OFFLOAD_REQ_INTR),
+                              CY_IPC_NO_NOTIFICATION, 1UL << IPC_OFFLOAD_REQ_CHANNEL);
+    if(NULL == ipc_offload_shared)
+    {
+        return;
+    }
+
+    Cy_IPC_Drv_ReadMsgWord(ipc_base, &message);
+    (void)Cy_IPC_Drv_LockRelease(ipc_base, CY_IPC_NO_NOTIFICATION);
+    if((uint32_t)(uintptr_t)ipc_offload_shared != message)
+    {
+        foreign_doorbells++;
+        return;
+    }
+
+    vTaskNotifyGiveFromISR(worker_task_handle, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_worker_task
+ *******************************************************************************
+ * Summary:
+ *  Waits for CM33 to hand over the shared block and announces the worker.
+ *  Then executes every queued descriptor on each doorbell, and rings the
+ *  completion doorbell once the ring is drained.
+ *
+ * Parameters:
+ *  void *arg: Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_worker_task(void *arg)
+{
+    ipc_offload_shared_t *shared;
+    ipc_offload_desc_t *desc;
+    uint32_t done;
+    uint32_t start;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    (void)cycle_counter_init();
+
+    do
+    {
+        vTaskDelay(pdMS_TO_TICKS(IPC_OFFLOAD_WORKER_POLL_MS));
+        shared = ipc_offload_worker_bind();
+    } while(NULL == shared);
+
+    /* From now on the doorbell interrupt handles the request doorbell. The
+     * handler must see the block before CM33 can see the worker ready and
+     * ring the first doorbell. */
+    ipc_offload_shared = shared;
+    __DMB();
+
+    shared->worker_clock_hz = SystemCoreClock;
+    shared->worker_ready = IPC_OFFLOAD_MAGIC;
+    ipc_offload_cache_clean(shared, IPC_OFFLOAD_CACHE_LINE);
+
+    while(true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        ipc_offload_cache_invalidate(&shared->head, sizeof(ipc_offload_index_t));
+        done = shared->done.value;
+        while(done != shared->head.value)
+        {
+            desc = &shared->desc[done & IPC_OFFLOAD_DESC_MASK];
+            ipc_offload_cache_invalidate(desc, sizeof(*desc));
+
+            start = cycle_counter_read();
+            desc->result = 0U;
+            desc->status = ipc_offload_execute(desc->op, desc->data, desc->length,
+                                               &desc->result);
+            desc->cycles = cycle_counter_read() - start;
+
+            /* status, result and cycles share the first cache line of the
+             * descriptor, and the completion must not become visible before
+             * them. */
+            ipc_offload_cache_clean(desc, IPC_OFFLOAD_CACHE_LINE);
+            done++;
+            shared->done.value = done;
+            ipc_offload_cache_clean(&shared->done, sizeof(ipc_offload_index_t));
+
+            ipc_offload_cache_invalidate(&shared->head, sizeof(ipc_offload_index_t));
+        }
+
+        /* A busy doorbell means CM33 has not yet taken the previous
+         * notification, and it drains every completion when it does. */
+        (void)Cy_IPC_Drv_SendMsgWord(Cy_IPC_Drv_GetIpcBaseAddress(IPC_OFFLOAD_CPL_CHANNEL),
+                                     1UL << IPC_OFFLOAD_CPL_INTR, done);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_worker_bind
+ *******************************************************************************
+ * Summary:
+ *  Reads the address of the shared block from the request doorbell rung by
+ *  CM33 at initialization, and checks the header of the block before the
+ *  worker uses it.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  ipc_offload_shared_t *: Shared block, or NULL if CM33 has not handed over
+ *  a valid one yet.
+ *
+ *******************************************************************************/
+static ipc_offload_shared_t *ipc_offload_worker_bind(void)
+{
+    IPC_STRUCT_Type *ipc_base = Cy_IPC_Drv_GetIpcBaseAddress(IPC_OFFLOAD_REQ_CHANNEL);
+    ipc_offload_shared_t *shared;
+    uint32_t message = 0U;
+
+    if(!Cy_IPC_Drv_IsLockAcquired(ipc_base))
+    {
+        return NULL;
+    }
+
+    Cy_IPC_Drv_ReadMsgWord(ipc_base, &message);
+    (void)Cy_IPC_Drv_LockRelease(ipc_base, CY_IPC_NO_NOTIFICATION);
+
+    shared = (ipc_offload_shared_t *)(uintptr_t)message;
+    if((NULL == shared) || (0U != (message % IPC_OFFLOAD_CACHE_LINE)))
+    {
+        foreign_doorbells++;
+        return NULL;
+    }
+
+    ipc_offload_cache_invalidate(shared, IPC_OFFLOAD_CACHE_LINE);
+    if((IPC_OFFLOAD_MAGIC != shared->magic) || (sizeof(ipc_offload_shared_t) != shared->size))
+    {
+        foreign_doorbells++;
+        return NULL;
+    }
+
+    return shared;
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_cache_invalidate
+ *******************************************************************************
+ * Summary:
+ *  Discards the cached copy of shared memory written by CM33.
+ *
+ * Parameters:
+ *  volatile void *addr: Start of the region, aligned to the cache line
+ *  uint32_t size: Size of the region
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_cache_invalidate(volatile void *addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr(addr, (int32_t)size);
+#else
+    CY_UNUSED_PARAMETER(addr);
+    CY_UNUSED_PARAMETER(size);
+#endif
+    __DMB();
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_cache_clean
+ *******************************************************************************
+ * Summary:
+ *  Writes shared memory updated by CM55 back so that CM33 observes it.
+ *
+ * Parameters:
+ *  volatile void *addr: Start of the region, aligned to the cache line
+ *  uint32_t size: Size of the region
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void ipc_offload_cache_clean(volatile void *addr, uint32_t size)
+{
+    __DMB();
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr(addr, (int32_t)size);
+#else
+    CY_UNUSED_PARAMETER(addr);
+    CY_UNUSED_PARAMETER(size);
+#endif
+}
+
+/* [] END OF FILE */
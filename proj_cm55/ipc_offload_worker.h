@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name:   ipc_offload_worker.h
+*
+* Description: This file is the public interface of ipc_offload_worker.c,
+* the CM55 side of the IPC pipeline through which CM33 offloads frame
+* processing.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_OFFLOAD_WORKER_H_
+#define IPC_OFFLOAD_WORKER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_result.h"
+
+/* Shared-memory layout of the IPC pipeline */
+#include "ipc_offload_shared.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Interrupt of the request doorbell. Must match IPC_OFFLOAD_REQ_INTR. */
+#ifndef IPC_OFFLOAD_REQ_IRQ
+#define IPC_OFFLOAD_REQ_IRQ                       ((IRQn_Type)(m55appcpuss_interrupts_ipc_dpslp_0_IRQn + IPC_OFFLOAD_REQ_INTR))
+#endif
+#define IPC_OFFLOAD_REQ_IRQ_PRIORITY              (3U)
+
+/* Worker task. */
+#define IPC_OFFLOAD_WORKER_TASK_STACK_SIZE        (configMINIMAL_STACK_SIZE * 4U)
+#define IPC_OFFLOAD_WORKER_TASK_PRIORITY          (configMAX_PRIORITIES - 1U)
+
+/* Period at which the worker polls for CM33 to hand over the shared block. */
+#define IPC_OFFLOAD_WORKER_POLL_MS                (10U)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t ipc_offload_worker_init(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* IPC_OFFLOAD_WORKER_H_ */
+
+/* [] END OF FILE */
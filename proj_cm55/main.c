@@ -49,13 +49,12 @@
 #include "cyabs_rtos.h"
 #include "cyabs_rtos_impl.h"
 
+/* IPC offload worker header file */
+#include "ipc_offload_worker.h"
+
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-#define TASK_NAME                ("CM55 Task")
-#define TASK_STACK_SIZE          (configMINIMAL_STACK_SIZE * 4U)
-#define TASK_PRIORITY            (configMAX_PRIORITIES - 1U)
-
 /* Enabling or disabling a MCWDT requires a wait time of upto 2 CLK_LF cycles
  * to come into effect. This wait time value will depend on the actual CLK_LF
  * frequency set by the BSP.
@@ -80,31 +79,6 @@ static mtb_hal_rtc_t rtc_obj;
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
-/*******************************************************************************
-* Function Name: cm55_task
-********************************************************************************
-* Summary:
-* This is the FreeRTOS task callback function.
-* It is suspended to enter deepsleep.
-*
-* Parameters:
-*  void * arg
-*
-* Return:
-*  void
-*
-*******************************************************************************/
-static void cm55_task(void * arg)
-{
-    CY_UNUSED_PARAMETER(arg);
-
-    for (;;)
-    {
-        /* Suspend the task to enter deepsleep */
-        vTaskSuspend(NULL);
-    }
-}
-
 /*******************************************************************************
 * Function Name: handle_app_error
 ********************************************************************************
@@ -256,7 +230,9 @@ static void setup_tickless_idle_timer(void)
 *    1. It initializes the device and board peripherals.
 *    2. It sets up the CLIB support library for CM55 CPU.
 *    3. It sets up the LPTimer instance for CM55 CPU.
-*    4. It creates the FreeRTOS application task 'cm55_task'
+*    4. It creates the IPC offload worker task, which executes the frame
+*       processing offloaded by CM33 and blocks, letting the core enter
+*       deepsleep, while no request is pending.
 *    5. It starts the RTOS task scheduler.
 *
 * Parameters:
@@ -288,12 +264,10 @@ int main(void)
     /* Enable global interrupts */
     __enable_irq();
 
-    /* Create the FreeRTOS Task */
-    result = xTaskCreate(cm55_task, TASK_NAME,
-                        TASK_STACK_SIZE, NULL,
-                        TASK_PRIORITY, NULL);
+    /* Create the IPC offload worker task */
+    result = ipc_offload_worker_init();
 
-    if( pdPASS == result )
+    if( CY_RSLT_SUCCESS == result )
     {
         /* Start the RTOS Scheduler */
         vTaskStartScheduler();
@@ -0,0 +1,391 @@
+#!/usr/bin/env python
+
+#******************************************************************************
+# File Name:   tcp_secure_benchmark.py
+#
+# Description: Load generator and latency benchmark for the secure TCP server.
+# It opens many concurrent TLS sessions, drives DATA frames through them and
+# reports round-trip latency percentiles and handshake rates as CSV or JSON.
+# In streaming mode it measures the throughput of the server streams instead.
+#
+#******************************************************************************
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************/
+
+#!/usr/bin/env python
+import argparse
+import asyncio
+import csv
+import json
+import os
+import ssl
+import struct
+import sys
+import time
+import zlib
+
+DEFAULT_PORT = 50007                         # Port of the TCP server
+
+# Application frame header and types (see TCP_FRAME_* in secure_tcp_server.h).
+FRAME_HEADER = struct.Struct('>BH')
+FRAME_TYPE_DATA = 0x05
+FRAME_TYPE_DATA_ACK = 0x06
+FRAME_TYPE_PROTOCOL_SELECT = 0x07
+FRAME_TYPE_PROTOCOL_ACK = 0x08
+FRAME_TYPE_STREAM_START = 0x09
+FRAME_TYPE_STREAM_CREDIT = 0x0A
+FRAME_TYPE_STREAM_STOP = 0x0B
+FRAME_TYPE_STREAM_DATA = 0x0C
+FRAME_TYPE_STREAM_REPORT = 0x0D
+FRAME_MAX_PAYLOAD_LEN = 509
+PROTOCOL_UNKNOWN = 0xFF
+
+# Credits granted when a stream starts (see TCP_STREAM_MAX_CREDITS in
+# secure_tcp_server.h). Afterwards, one credit is granted per block received.
+STREAM_CREDITS = 4
+STREAM_REPORT = struct.Struct('>IIIIH')
+
+READ_CHUNK = 4096
+
+class TlsStream:
+    """TLS over an asyncio stream through memory BIOs, so that a session from
+    an earlier connection can be offered for resumption, which the asyncio
+    SSL transport does not support."""
+
+    def __init__(self, reader, writer, tls):
+        self.reader = reader
+        self.writer = writer
+        self.incoming = tls[0]
+        self.outgoing = tls[1]
+        self.tls = tls[2]
+
+    @classmethod
+    async def connect(cls, host, port, context, hostname, session):
+        reader, writer = await asyncio.open_connection(host, port)
+        incoming = ssl.MemoryBIO()
+        outgoing = ssl.MemoryBIO()
+        tls = context.wrap_bio(incoming, outgoing, server_hostname=hostname, session=session)
+        stream = cls(reader, writer, (incoming, outgoing, tls))
+        while True:
+            try:
+                tls.do_handshake()
+                break
+            except ssl.SSLWantReadError:
+                await stream._pump()
+        await stream._flush()
+        return stream
+
+    async def _flush(self):
+        data = self.outgoing.read()
+        if data:
+            self.writer.write(data)
+            await self.writer.drain()
+
+    async def _pump(self):
+        await self._flush()
+        data = await self.reader.read(READ_CHUNK)
+        if not data:
+            raise ConnectionError("Connection closed by the server")
+        self.incoming.write(data)
+
+    async def send(self, data):
+        self.tls.write(data)
+        await self._flush()
+
+    async def recv_exact(self, length):
+        data = b''
+        while len(data) < length:
+            try:
+                data += self.tls.read(length - len(data))
+            except ssl.SSLWantReadError:
+                await self._pump()
+        return data
+
+    async def recv_frame(self):
+        frame_type, length = FRAME_HEADER.unpack(await self.recv_exact(FRAME_HEADER.size))
+        return frame_type, await self.recv_exact(length)
+
+    async def send_frame(self, frame_type, payload):
+        await self.send(FRAME_HEADER.pack(frame_type, len(payload)) + payload)
+
+    @property
+    def session(self):
+        return self.tls.session
+
+    @property
+    def session_reused(self):
+        return self.tls.session_reused
+
+    async def close(self):
+        try:
+            self.tls.unwrap()
+        except ssl.SSLError:
+            pass
+        try:
+            await self._flush()
+        except ConnectionError:
+            pass
+        self.writer.close()
+        try:
+            await self.writer.wait_closed()
+        except (ConnectionError, ssl.SSLError):
+            pass
+
+class Results:
+    def __init__(self):
+        self.latencies_ms = []
+        self.handshake_ms = []
+        self.full_handshakes = 0
+        self.resumed_handshakes = 0
+        self.handshake_failures = 0
+        self.crc_errors = 0
+        self.errors = 0
+        self.bytes_out = 0
+        self.bytes_in = 0
+        self.stream_errors = 0
+        self.stream_reports = []
+        self.session = None
+
+def percentile(values, fraction):
+    if not values:
+        return None
+    ordered = sorted(values)
+    rank = max(0, min(len(ordered) - 1, int(fraction * len(ordered) + 0.999999) - 1))
+    return ordered[rank]
+
+async def open_session(args, context, results):
+    start = time.perf_counter()
+    try:
+        stream = await TlsStream.connect(args.address, args.port, context, args.hostname,
+                                         results.session if args.resume else None)
+    except (OSError, ConnectionError, ssl.SSLError):
+        results.handshake_failures += 1
+        return None
+    results.handshake_ms.append((time.perf_counter() - start) * 1000.0)
+    if stream.session_reused:
+        results.resumed_handshakes += 1
+    else:
+        results.full_handshakes += 1
+
+    await stream.send_frame(FRAME_TYPE_PROTOCOL_SELECT, args.protocol.encode())
+    while True:
+        frame_type, payload = await stream.recv_frame()
+        if frame_type == FRAME_TYPE_PROTOCOL_ACK:
+            if len(payload) != 1 or payload[0] == PROTOCOL_UNKNOWN:
+                raise SystemExit("Server does not speak protocol %s" % args.protocol)
+            return stream
+
+async def round_trip(stream, payload, results):
+    await stream.send_frame(FRAME_TYPE_DATA, payload)
+    results.bytes_out += FRAME_HEADER.size + len(payload)
+    while True:
+        frame_type, ack = await stream.recv_frame()
+        if frame_type == FRAME_TYPE_DATA_ACK:
+            if struct.unpack('>I', ack)[0] != zlib.crc32(payload):
+                results.crc_errors += 1
+            return
+
+async def run_session(args, context, results, deadline):
+    payload = os.urandom(args.payload)
+    connections = 0
+    while time.perf_counter() < deadline and connections <= args.reconnects:
+        stream = await open_session(args, context, results)
+        connections += 1
+        if stream is None:
+            continue
+        # Spread the commands of one connection over its share of the run.
+        connection_deadline = min(deadline, time.perf_counter() +
+                                  args.duration / (args.reconnects + 1))
+        next_send = time.perf_counter()
+        try:
+            while time.perf_counter() < connection_deadline:
+                if args.rate > 0:
+                    delay = next_send - time.perf_counter()
+                    if delay > 0:
+                        await asyncio.sleep(delay)
+                    # Measure from the intended send time, so that a stalled
+                    # server is not hidden by the sender waiting for it.
+                    start = next_send
+                    next_send += 1.0 / args.rate
+                else:
+                    start = time.perf_counter()
+                await round_trip(stream, payload, results)
+                results.latencies_ms.append((time.perf_counter() - start) * 1000.0)
+        except (OSError, ConnectionError, ssl.SSLError):
+            results.errors += 1
+        # Keep a session once traffic has flowed, as a TLS 1.3 server only
+        # sends its ticket after the handshake.
+        if args.resume and results.session is None:
+            results.session = stream.session
+        await stream.close()
+
+async def run_stream(args, context, results, deadline):
+    stream = await open_session(args, context, results)
+    if stream is None:
+        return
+    expected = 0
+    stopping = False
+    try:
+        await stream.send_frame(FRAME_TYPE_STREAM_START, struct.pack('>I', 0))
+        await stream.send_frame(FRAME_TYPE_STREAM_CREDIT, struct.pack('>H', STREAM_CREDITS))
+        while True:
+            if not stopping and time.perf_counter() >= deadline:
+                await stream.send_frame(FRAME_TYPE_STREAM_STOP, b'')
+                stopping = True
+            frame_type, payload = await stream.recv_frame()
+            if frame_type == FRAME_TYPE_STREAM_DATA:
+                sequence, = struct.unpack_from('>I', payload)
+                block = payload[4:]
+                first = block[0] if block else 0
+                if sequence != expected or any(value != (first + index) & 0xFF
+                                               for index, value in enumerate(block)):
+                    results.stream_errors += 1
+                expected = sequence + 1
+                results.bytes_in += FRAME_HEADER.size + len(payload)
+                if not stopping:
+                    await stream.send_frame(FRAME_TYPE_STREAM_CREDIT, struct.pack('>H', 1))
+            elif frame_type == FRAME_TYPE_STREAM_REPORT:
+                results.stream_reports.append(STREAM_REPORT.unpack(payload))
+                break
+    except (OSError, ConnectionError, ssl.SSLError):
+        results.errors += 1
+    await stream.close()
+
+def summarize_stream(args, results, elapsed):
+    rates = [report[3] for report in results.stream_reports]
+    loads = [report[4] / 10.0 for report in results.stream_reports]
+    return {
+        "sessions": args.sessions,
+        "duration_s": round(elapsed, 3),
+        "streams_reported": len(results.stream_reports),
+        "client_mb_per_s": round(results.bytes_in / elapsed / 1e6, 3),
+        "server_mb_per_s": round(sum(rates) / 1e6, 3),
+        "stream_mb_per_s_min": round(min(rates) / 1e6, 3) if rates else None,
+        "cpu_percent_per_stream_max": max(loads) if loads else None,
+        "cpu_percent_total": round(sum(loads), 1),
+        "stream_errors": results.stream_errors,
+        "handshake_failures": results.handshake_failures,
+        "errors": results.errors,
+    }
+
+def summarize(args, results, elapsed):
+    summary = {
+        "sessions": args.sessions,
+        "protocol": args.protocol,
+        "payload_bytes": args.payload,
+        "rate_per_session": args.rate,
+        "duration_s": round(elapsed, 3),
+        "round_trips": len(results.latencies_ms),
+        "round_trips_per_s": round(len(results.latencies_ms) / elapsed, 1),
+        "throughput_kbps": round(results.bytes_out * 8 / elapsed / 1000.0, 1),
+        "p50_ms": percentile(results.latencies_ms, 0.50),
+        "p99_ms": percentile(results.latencies_ms, 0.99),
+        "p999_ms": percentile(results.latencies_ms, 0.999),
+        "max_ms": max(results.latencies_ms) if results.latencies_ms else None,
+        "handshakes_per_s": round((results.full_handshakes + results.resumed_handshakes) / elapsed, 2),
+        "handshake_p50_ms": percentile(results.handshake_ms, 0.50),
+        "handshake_p99_ms": percentile(results.handshake_ms, 0.99),
+        "full_handshakes": results.full_handshakes,
+        "resumed_handshakes": results.resumed_handshakes,
+        "handshake_failures": results.handshake_failures,
+        "crc_errors": results.crc_errors,
+        "errors": results.errors,
+    }
+    for key, value in summary.items():
+        if isinstance(value, float) and key.endswith("_ms"):
+            summary[key] = round(value, 3)
+    return summary
+
+def write_results(args, summary):
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump(summary, out, indent=2)
+    if args.csv:
+        new_file = not os.path.exists(args.csv)
+        with open(args.csv, "a", newline="") as out:
+            writer = csv.DictWriter(out, fieldnames=list(summary.keys()))
+            if new_file:
+                writer.writeheader()
+            writer.writerow(summary)
+
+async def main(args):
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    context.load_cert_chain(certfile="client.crt", keyfile="client.key")
+    context.load_verify_locations(cafile="root_ca.crt")
+    context.set_alpn_protocols([args.protocol])
+
+    results = Results()
+    start = time.perf_counter()
+    deadline = start + args.duration
+    runner = run_stream if args.stream else run_session
+    await asyncio.gather(*(runner(args, context, results, deadline)
+                           for _ in range(args.sessions)))
+    elapsed = time.perf_counter() - start
+    summary = summarize_stream(args, results, elapsed) if args.stream else summarize(args, results, elapsed)
+
+    print("================================================================================")
+    for key, value in summary.items():
+        print("  %-20s %s" % (key, value))
+    write_results(args, summary)
+
+parser = argparse.ArgumentParser(description="Load generator and latency benchmark for the secure TCP server")
+parser.add_argument("address", help="IPv4 or IPv6 address of the kit")
+parser.add_argument("--port", type=int, default=DEFAULT_PORT)
+parser.add_argument("--hostname", default="myServer", help="Common name of the server certificate")
+parser.add_argument("--sessions", type=int, default=4,
+                    help="Concurrent TLS sessions (the server serves TCP_SERVER_MAX_CLIENTS at once)")
+parser.add_argument("--duration", type=float, default=10.0, help="Length of the run in seconds")
+parser.add_argument("--rate", type=float, default=0.0,
+                    help="DATA frames per second per session, 0 for as fast as possible")
+parser.add_argument("--payload", type=int, default=64, help="DATA payload length in bytes")
+parser.add_argument("--protocol", default="telemetry/1", choices=("ctrl/1", "telemetry/1"))
+parser.add_argument("--reconnects", type=int, default=0,
+                    help="Times each session disconnects and connects again during the run")
+parser.add_argument("--resume", action="store_true",
+                    help="Offer the session of the first handshake for resumption")
+parser.add_argument("--stream", action="store_true",
+                    help="Measure the throughput of the server streams instead of the round trips")
+parser.add_argument("--csv", help="Append the results as a row to this CSV file")
+parser.add_argument("--json", help="Write the results to this JSON file")
+arguments = parser.parse_args()
+
+if arguments.stream and arguments.protocol != "telemetry/1":
+    parser.error("--stream needs the telemetry/1 protocol")
+if not 0 < arguments.payload <= FRAME_MAX_PAYLOAD_LEN:
+    parser.error("--payload must be between 1 and %d" % FRAME_MAX_PAYLOAD_LEN)
+
+try:
+    asyncio.run(main(arguments))
+except KeyboardInterrupt:
+    sys.exit(1)
+
+# [] END OF FILE
@@ -43,12 +43,173 @@
 #!/usr/bin/env python
 import socket
 import ssl
+import struct
 import sys
 
 # IP details for the TCP server
 DEFAULT_PORT = 50007                         # Port of the TCP server
+
+# Application frame header: 1-byte type followed by a 2-byte big-endian
+# payload length (see TCP_FRAME_* in secure_tcp_server.h).
+FRAME_HEADER = struct.Struct('>BH')
+FRAME_TYPE_LED_CMD = 0x01
+FRAME_TYPE_LED_ACK = 0x02
+FRAME_TYPE_STATS_REQ = 0x03
+FRAME_TYPE_STATS_RSP = 0x04
+FRAME_TYPE_PROTOCOL_SELECT = 0x07
+FRAME_TYPE_PROTOCOL_ACK = 0x08
+FRAME_TYPE_TRACE_REQ = 0x0E
+FRAME_TYPE_TRACE_RSP = 0x0F
+FRAME_TYPE_POWER_POLICY = 0x10
+FRAME_TYPE_POWER_REPORT = 0x11
+
+# Application protocol spoken by this client (see TCP_PROTOCOL_* in
+# secure_tcp_server.h). It is offered through ALPN and confirmed with a
+# PROTOCOL_SELECT frame.
+PROTOCOL_CONTROL = "ctrl/1"
+PROTOCOL_UNKNOWN = 0xFF
+
+# Snapshot carried by a STATS_RSP frame (see SERVER_STATS_SNAPSHOT_MAX_LEN in
+# server_stats.h).
+STATS_COUNTERS = ("accepts", "handshake failures", "sessions rejected",
+                  "bytes in", "bytes out", "receive calls", "records out",
+                  "link ups", "pool fallbacks", "sessions evicted", "tx drops")
+STATS_HWMS = (("rx buffer", "bytes"), ("tx batch", "bytes"), ("accept queue", "connections"),
+              ("time to listen", "ms"), ("small blocks", "blocks"), ("medium blocks", "blocks"),
+              ("large blocks", "blocks"), ("output records", "blocks"),
+              ("input records", "blocks"), ("lwip pbufs", "pbufs"), ("lwip tcp pcbs", "pcbs"),
+              ("lwip tcp segments", "segments"), ("lwip heap", "bytes"))
+STATS_HANDSHAKE_BOUNDS_MS = (50, 100, 200, 500, 1000, 2000, 5000)
+STATS_TASK_NAME_LEN = 8
+STATS_CORES = ("CM33", "CM55")
+
+# Records carried by TRACE_RSP frames (see TCP_FRAME_TRACE_* in
+# secure_tcp_server.h and trace_event_t in trace_ring.h).
+TRACE_RSP_HEADER = struct.Struct('>IHHBB')
+TRACE_RSP_TRUNCATED = 0x01
+TRACE_RECORD = struct.Struct('>IBBH')
+TRACE_NO_SESSION = 0xFF
+TRACE_EVENTS = {1: "button isr", 2: "led queued", 3: "accept ready", 4: "accept start",
+                5: "accept done", 6: "rx ready", 7: "rx start", 8: "rx done",
+                9: "tx start", 10: "tx done"}
+# Power policies, in the order of power_policy_t in power_policy.h.
+POWER_POLICIES = ("low-latency", "eco")
+
+# Stages of the latency breakdown: each runs from a trace point to the next
+# one of the listed kind.
+TRACE_STAGES = (("button isr", "led queued"), ("led queued", "tx start"),
+                ("tx start", "tx done"), ("accept ready", "accept start"),
+                ("accept start", "accept done"), ("rx ready", "rx start"),
+                ("rx start", "rx done"))
+
+def recv_exact(sock, length):
+    data = b''
+    while len(data) < length:
+        chunk = sock.recv(length - len(data))
+        if not chunk:
+            raise ConnectionError("Connection closed by the server")
+        data += chunk
+    return data
+
+def recv_frame(sock):
+    frame_type, length = FRAME_HEADER.unpack(recv_exact(sock, FRAME_HEADER.size))
+    return frame_type, recv_exact(sock, length)
+
+def send_frame(sock, frame_type, payload):
+    sock.sendall(FRAME_HEADER.pack(frame_type, len(payload)) + payload)
+
+def print_stats(payload):
+    offset = 0
+    def take(fmt):
+        nonlocal offset
+        values = struct.unpack_from(fmt, payload, offset)
+        offset += struct.calcsize(fmt)
+        return values
+
+    version, uptime_ms = take('>BI')
+    print("Server statistics (version %d, uptime %d ms):" % (version, uptime_ms))
+    if version >= 3:
+        counters, = take('>B')
+    else:
+        counters = 7
+    for index, value in enumerate(take('>%dI' % counters)):
+        name = STATS_COUNTERS[index] if index < len(STATS_COUNTERS) else "counter %d" % index
+        print("  %-20s %d" % (name, value))
+    rate_in, rate_out = take('>II')
+    print("  %-20s %d receive calls, %d records out" % ("per second", rate_in, rate_out))
+    buckets, = take('>B')
+    bounds = ["< %d ms" % bound for bound in STATS_HANDSHAKE_BOUNDS_MS] + [">= %d ms" % STATS_HANDSHAKE_BOUNDS_MS[-1]]
+    for bound, value in zip(bounds, take('>%dI' % buckets)):
+        print("  handshakes %-9s %d" % (bound, value))
+    if version >= 3:
+        hwms, = take('>B')
+    else:
+        hwms = 3
+    for index, value in enumerate(take('>%dI' % hwms)):
+        name, unit = STATS_HWMS[index] if index < len(STATS_HWMS) else ("mark %d" % index, "")
+        print("  %-20s %d %s high-water" % (name, value, unit))
+    if version >= 2:
+        offloaded, local = take('>II')
+        print("  %-20s %d on CM55, %d on CM33" % ("offload requests", offloaded, local))
+    if version >= 5:
+        cores, = take('>B')
+        for core in range(cores):
+            sessions, load = take('>HH')
+            name = STATS_CORES[core] if core < len(STATS_CORES) else str(core)
+            print("  core %-15s %d sessions, %5.1f %% CPU" % (name, sessions, load / 10.0))
+    tasks, = take('>B')
+    for _ in range(tasks):
+        if version >= 4:
+            name, permille, stack_free = take('>%dsHH' % STATS_TASK_NAME_LEN)
+            print("  task %-15s %5.1f %% of awake CPU, %d stack bytes never used"
+                  % (name.rstrip(b'\0').decode(), permille / 10.0, stack_free))
+        else:
+            name, permille = take('>%dsH' % STATS_TASK_NAME_LEN)
+            print("  task %-15s %5.1f %% of awake CPU" % (name.rstrip(b'\0').decode(), permille / 10.0))
+
+def print_trace(records, clock_hz):
+    print("Trace of %d records (core clock %d Hz):" % (len(records), clock_hz))
+    if not records:
+        return
+    origin = records[0][0]
+    elapsed = 0
+    previous = origin
+    for cycles, event, session, value in records:
+        elapsed += (cycles - previous) & 0xFFFFFFFF
+        previous = cycles
+        print("  %12d cycles %10.1f us  %-13s %-9s %d" %
+              (elapsed, elapsed * 1e6 / clock_hz, TRACE_EVENTS.get(event, "event %d" % event),
+               "" if session == TRACE_NO_SESSION else "session %d" % session, value))
+    print("Latency breakdown (mean cycles, mean us, samples):")
+    for start, end in TRACE_STAGES:
+        spans = []
+        for index, (cycles, event, session, _) in enumerate(records):
+            if TRACE_EVENTS.get(event) != start:
+                continue
+            for later, later_event, later_session, _ in records[index + 1:]:
+                if TRACE_EVENTS.get(later_event) == end and \
+                   (session == TRACE_NO_SESSION or later_session == session):
+                    spans.append((later - cycles) & 0xFFFFFFFF)
+                    break
+        if spans:
+            mean = sum(spans) / len(spans)
+            print("  %-13s -> %-13s %12.0f %10.1f %5d" % (start, end, mean, mean * 1e6 / clock_hz, len(spans)))
+
+def print_power_report(payload):
+    print("Power policy in effect:", POWER_POLICIES[payload[0]] if payload[0] < len(POWER_POLICIES) else payload[0])
+    for index, name in enumerate(POWER_POLICIES):
+        responses, mean_us, max_us, deep_sleeps, held_off = struct.unpack_from('>5I', payload, 1 + index * 20)
+        print("  %-12s %d responses, wake-up to response %d us mean, %d us max, "
+              "%d deep sleeps, %d held off" % (name, responses, mean_us, max_us, deep_sleeps, held_off))
+
 arguments = len(sys.argv) - 1
 
+request_stats = (arguments == 3) and (sys.argv[3] == "stats")
+request_trace = (arguments == 3) and (sys.argv[3] == "trace")
+request_power = (arguments == 3) and (sys.argv[3] in ("power",) + POWER_POLICIES)
+if request_stats or request_trace or request_power:
+    arguments = 2
+
 if ((arguments == 2) and sys.argv[1] == "ipv4"):
     print("================================================================================")
     print("TCP Secure Client (IPv4 addressing mode)")
@@ -66,6 +227,9 @@ else:
     print("python tcp_secure_client ipv4 <IPv4 Address>")
     print("If you are using IPv6 addressing mode, enter the command as:")
     print("python tcp_secure_client ipv6 <IPv6 Address>")
+    print("Append 'stats' to request a snapshot of the server statistics after connecting")
+    print("Append 'trace' to dump and decode the trace ring of the server after connecting")
+    print("Append 'power' to report the power policy of the server, or 'low-latency' or 'eco' to select it")
     sys.exit(1)
 
 DEFAULT_IP = sys.argv[2]
@@ -73,24 +237,59 @@ DEFAULT_IP = sys.argv[2]
 context = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
 context.load_cert_chain(certfile="client.crt", keyfile="client.key")
 context.load_verify_locations(cafile="root_ca.crt")
+context.set_alpn_protocols([PROTOCOL_CONTROL])
 ssl_sock = context.wrap_socket(s, server_hostname="myServer")
 
 ssl_sock.connect((DEFAULT_IP, DEFAULT_PORT))
 print("Connected to TCP Server (IP Address: ", DEFAULT_IP, "Port: ", DEFAULT_PORT, " )")
+send_frame(ssl_sock, FRAME_TYPE_PROTOCOL_SELECT, PROTOCOL_CONTROL.encode())
+
+if request_stats:
+    send_frame(ssl_sock, FRAME_TYPE_STATS_REQ, b'')
+if request_trace:
+    send_frame(ssl_sock, FRAME_TYPE_TRACE_REQ, b'')
+if request_power:
+    policy = b'' if sys.argv[3] == "power" else bytes([POWER_POLICIES.index(sys.argv[3])])
+    send_frame(ssl_sock, FRAME_TYPE_POWER_POLICY, policy)
+trace_records = []
 
 try:
     while True:
         print("================================================================================")
-        data = ssl_sock.read();
+        frame_type, payload = recv_frame(ssl_sock)
+        if frame_type == FRAME_TYPE_STATS_RSP:
+            print_stats(payload)
+            continue
+        if frame_type == FRAME_TYPE_POWER_REPORT:
+            print_power_report(payload)
+            continue
+        if frame_type == FRAME_TYPE_TRACE_RSP:
+            clock_hz, total, first, count, flags = TRACE_RSP_HEADER.unpack_from(payload)
+            trace_records += [TRACE_RECORD.unpack_from(payload, TRACE_RSP_HEADER.size + index * TRACE_RECORD.size)
+                              for index in range(count)]
+            if flags & TRACE_RSP_TRUNCATED:
+                print("Trace dump truncated after %d of %d records; the server keeps them, "
+                      "request the trace again to get them all" % (first, total))
+                print_trace(trace_records, clock_hz)
+                trace_records = []
+            elif first + count >= total:
+                print_trace(trace_records, clock_hz)
+                trace_records = []
+            continue
+        if frame_type == FRAME_TYPE_PROTOCOL_ACK and len(payload) == 1:
+            if payload[0] == PROTOCOL_UNKNOWN:
+                print("Server does not speak protocol", PROTOCOL_CONTROL)
+            else:
+                print("Protocol", PROTOCOL_CONTROL, "selected")
+            continue
+        if frame_type != FRAME_TYPE_LED_CMD or len(payload) != 1:
+            continue
         print("Message from Server:")
-        if data.decode('utf-8') == '0':
+        if payload == b'0':
             print("LED OFF")
-            message = 'LED OFF ACK'
-            ssl_sock.write(message.encode('utf-8'))
-        if data.decode('utf-8') == '1':
+        elif payload == b'1':
             print("LED ON")
-            message = 'LED ON ACK'
-            ssl_sock.write(message.encode('utf-8'))
+        send_frame(ssl_sock, FRAME_TYPE_LED_ACK, payload)
         print("Acknowledgement sent to secure TCP server")
 
 except KeyboardInterrupt:
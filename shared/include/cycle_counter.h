@@ -0,0 +1,104 @@
+/******************************************************************************
+* File Name:   cycle_counter.h
+*
+* Description: This file contains helpers to read the CPU cycle counter
+* of the Data Watchpoint and Trace (DWT) unit, used to time short code paths.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+
+/*******************************************************************************
+ * Function Name: cycle_counter_init
+ *******************************************************************************
+ * Summary:
+ *  Enables the DWT cycle counter. Safe to call more than once.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool: false if the core does not implement the cycle counter.
+ *
+ *******************************************************************************/
+static inline bool cycle_counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if(0U != (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk))
+    {
+        return false;
+    }
+
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: cycle_counter_read
+ *******************************************************************************
+ * Summary:
+ *  Returns the free-running 32-bit CPU cycle count. Differences between two
+ *  reads are valid across a single wrap of the counter.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t: Current cycle count.
+ *
+ *******************************************************************************/
+static inline uint32_t cycle_counter_read(void)
+{
+    return DWT->CYCCNT;
+}
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* CYCLE_COUNTER_H_ */
+
+/* [] END OF FILE */
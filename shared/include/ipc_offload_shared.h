@@ -0,0 +1,241 @@
+/******************************************************************************
+* File Name:   ipc_offload_shared.h
+*
+* Description: This file defines the shared-memory layout of the IPC
+* pipeline through which the CM33 non-secure application offloads frame
+* processing to the CM55 core. It is included by both projects.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_OFFLOAD_SHARED_H_
+#define IPC_OFFLOAD_SHARED_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+
+/* Written by CM33 once the shared block is initialized, and by CM55 to
+ * worker_ready once it serves requests. */
+#define IPC_OFFLOAD_MAGIC                         (0x4F464C31UL)
+
+/* Number of descriptors. Must be a power of two. */
+#define IPC_OFFLOAD_DESC_COUNT                    (8U)
+
+/* Largest input of a single operation. */
+#define IPC_OFFLOAD_MAX_DATA_LEN                  (512U)
+
+/* Every object CM55 reads or writes through its data cache is aligned to,
+ * and padded to a multiple of, the cache line. */
+#define IPC_OFFLOAD_CACHE_LINE                    (32U)
+
+/* IPC channels and interrupt structures used as doorbells. The request
+ * doorbell is rung by CM33 once the shared block is initialized and after
+ * queuing descriptors, and the completion doorbell by CM55 after completing
+ * them. They must not be used by anything else in the device configuration.
+ * The message word of the request doorbell is the address of the shared
+ * block, so that CM55 does not depend on both images placing it at the same
+ * address.
+ */
+#ifndef IPC_OFFLOAD_REQ_CHANNEL
+#define IPC_OFFLOAD_REQ_CHANNEL                   (12U)
+#endif
+#ifndef IPC_OFFLOAD_REQ_INTR
+#define IPC_OFFLOAD_REQ_INTR                      (4U)
+#endif
+#ifndef IPC_OFFLOAD_CPL_CHANNEL
+#define IPC_OFFLOAD_CPL_CHANNEL                   (13U)
+#endif
+#ifndef IPC_OFFLOAD_CPL_INTR
+#define IPC_OFFLOAD_CPL_INTR                      (5U)
+#endif
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+
+/* Operations. */
+typedef enum
+{
+    IPC_OFFLOAD_OP_CRC32 = 1
+} ipc_offload_op_t;
+
+/* Completion status of a descriptor. */
+typedef enum
+{
+    IPC_OFFLOAD_STATUS_OK = 0,
+    IPC_OFFLOAD_STATUS_BAD_OP,
+    IPC_OFFLOAD_STATUS_BAD_LENGTH
+} ipc_offload_status_t;
+
+/* Descriptor. CM33 fills in op, length and data; CM55 fills in status,
+ * result and cycles. */
+typedef struct
+{
+    uint32_t op;
+    uint32_t length;
+    uint32_t status;
+    uint32_t result;
+
+    /* CM55 cycles spent executing the operation. */
+    uint32_t cycles;
+    uint32_t reserved[3];
+
+    uint8_t data[IPC_OFFLOAD_MAX_DATA_LEN];
+} ipc_offload_desc_t;
+
+/* Ring index, alone in its cache line. */
+typedef struct
+{
+    volatile uint32_t value;
+    uint8_t padding[IPC_OFFLOAD_CACHE_LINE - sizeof(uint32_t)];
+} ipc_offload_index_t;
+
+/* Shared block. The three indices run freely and are reduced modulo
+ * IPC_OFFLOAD_DESC_COUNT when indexing the descriptors:
+ *  head - descriptors submitted, written by CM33
+ *  done - descriptors completed, written by CM55 (the completion mailbox)
+ *  tail - completions consumed, written by CM33
+ * CM55 completes descriptors in submission order.
+ */
+typedef struct
+{
+    volatile uint32_t magic;
+    volatile uint32_t worker_ready;
+
+    /* sizeof(ipc_offload_shared_t) as built into CM33, checked by CM55
+     * together with magic before it uses the block. */
+    volatile uint32_t size;
+
+    /* CM55 core clock, to convert the cycles of a descriptor to time. */
+    volatile uint32_t worker_clock_hz;
+    uint8_t padding[IPC_OFFLOAD_CACHE_LINE - (4U * sizeof(uint32_t))];
+
+    ipc_offload_index_t head;
+    ipc_offload_index_t done;
+    ipc_offload_index_t tail;
+
+    ipc_offload_desc_t desc[IPC_OFFLOAD_DESC_COUNT];
+} ipc_offload_shared_t;
+
+/*******************************************************************************
+ * Function Name: ipc_offload_crc32
+ *******************************************************************************
+ * Summary:
+ *  Computes the CRC-32 (IEEE 802.3, as zlib.crc32()) of a buffer, four bits
+ *  at a time.
+ *
+ * Parameters:
+ *  const uint8_t *data: Input
+ *  uint32_t length: Input length
+ *
+ * Return:
+ *  uint32_t: CRC-32 of the input.
+ *
+ *******************************************************************************/
+static inline uint32_t ipc_offload_crc32(const uint8_t *data, uint32_t length)
+{
+    static const uint32_t nibble_table[16] =
+    {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+        0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+        0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+        0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+    };
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint32_t index;
+
+    for(index = 0; index < length; index++)
+    {
+        crc ^= data[index];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0FU];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0FU];
+    }
+
+    return crc ^ 0xFFFFFFFFUL;
+}
+
+/*******************************************************************************
+ * Function Name: ipc_offload_execute
+ *******************************************************************************
+ * Summary:
+ *  Executes an operation. The same code runs on CM55 for offloaded requests
+ *  and on CM33 for requests that fall back to local processing.
+ *
+ * Parameters:
+ *  uint32_t op: Operation, one of ipc_offload_op_t
+ *  const uint8_t *data: Input
+ *  uint32_t length: Input length
+ *  uint32_t *result: Result of the operation
+ *
+ * Return:
+ *  uint32_t: Completion status, one of ipc_offload_status_t.
+ *
+ *******************************************************************************/
+static inline uint32_t ipc_offload_execute(uint32_t op, const uint8_t *data,
+                                           uint32_t length, uint32_t *result)
+{
+    if(length > IPC_OFFLOAD_MAX_DATA_LEN)
+    {
+        return IPC_OFFLOAD_STATUS_BAD_LENGTH;
+    }
+
+    switch(op)
+    {
+        case IPC_OFFLOAD_OP_CRC32:
+            *result = ipc_offload_crc32(data, length);
+            return IPC_OFFLOAD_STATUS_OK;
+
+        default:
+            return IPC_OFFLOAD_STATUS_BAD_OP;
+    }
+}
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* IPC_OFFLOAD_SHARED_H_ */
+
+/* [] END OF FILE */